@@ -63,6 +63,8 @@ fast_downward_plugin(
         operator_id
         option_parser
         option_parser_util
+        packed_state_hashing
+        packed_state_view
         per_state_array
         per_state_bitset
         per_state_information
@@ -80,7 +82,7 @@ fast_downward_plugin(
         task_id
         task_proxy
 
-    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES
+    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER MAPPED_SEGMENT_POOL ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES
     CORE_PLUGIN
 )
 
@@ -141,6 +143,13 @@ fast_downward_plugin(
         open_lists/best_first_open_list
 )
 
+fast_downward_plugin(
+    NAME BUCKET_OPEN_LIST
+    HELP "Open list that stores entries in an array of buckets indexed by up to two evaluators"
+    SOURCES
+        open_lists/bucket_open_list
+)
+
 fast_downward_plugin(
     NAME EPSILON_GREEDY_OPEN_LIST
     HELP "Open list that chooses an entry randomly with probability epsilon"
@@ -225,6 +234,24 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME SHARDED_STATE_REGISTRY
+    HELP "Thread-safe state registry with sharded storage"
+    SOURCES
+        sharded_per_state_information
+        sharded_state_registry
+    DEPENDS INT_HASH_SET INT_PACKER SEGMENTED_VECTOR TASK_PROPERTIES
+    DEPENDENCY_ONLY
+)
+
+fast_downward_plugin(
+    NAME MAPPED_SEGMENT_POOL
+    HELP "File-backed memory for segmented vectors"
+    SOURCES
+        algorithms/mapped_segment_pool
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME SEGMENTED_VECTOR
     HELP "Memory-friendly and vector-like data structure"
@@ -355,6 +382,22 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME BREADTH_FIRST_HEURISTIC_SEARCH
+    HELP "Breadth-first heuristic search with divide-and-conquer solution reconstruction"
+    SOURCES
+        search_engines/breadth_first_heuristic_search
+    DEPENDS SUCCESSOR_GENERATOR
+)
+
+fast_downward_plugin(
+    NAME PIPELINED_ASTAR_SEARCH
+    HELP "A* search with concurrent heuristic evaluation"
+    SOURCES
+        search_engines/pipelined_astar_search
+    DEPENDS SEARCH_COMMON SUCCESSOR_GENERATOR
+)
+
 fast_downward_plugin(
     NAME PLUGIN_ASTAR
     HELP "A* search"
@@ -419,6 +462,14 @@ fast_downward_plugin(
     DEPENDS G_EVALUATOR ORDERED_SET PREF_EVALUATOR SEARCH_COMMON SUCCESSOR_GENERATOR
 )
 
+fast_downward_plugin(
+    NAME HDA_STAR_SEARCH
+    HELP "Hash-distributed A* search algorithm"
+    SOURCES
+        search_engines/hda_star_search
+    DEPENDS SEARCH_COMMON SHARDED_STATE_REGISTRY SUCCESSOR_GENERATOR
+)
+
 fast_downward_plugin(
     NAME ITERATED_SEARCH
     HELP "Iterated search algorithm"
@@ -616,10 +667,12 @@ fast_downward_plugin(
         cegar/split_selector
         cegar/subtask_generators
         cegar/transition
+        cegar/transition_list
         cegar/transition_system
         cegar/types
         cegar/utils
         cegar/utils_landmarks
+        cegar/varint
     DEPENDS ADDITIVE_HEURISTIC DYNAMIC_BITSET EXTRA_TASKS LANDMARKS PRIORITY_QUEUES TASK_PROPERTIES
 )
 
@@ -106,6 +106,13 @@ public:
     virtual void convert_state_values(
         std::vector<int> &values,
         const AbstractTask *ancestor_task) const = 0;
+    /*
+      Return false if convert_state_values() leaves the state values of the
+      given ancestor task unchanged. In this case, states of the ancestor
+      task can be used for this task directly.
+    */
+    virtual bool does_convert_state_values(
+        const AbstractTask *ancestor_task) const = 0;
 };
 
 #endif
@@ -291,6 +291,37 @@ public:
         return insert(key, hasher(key));
     }
 
+    /*
+      Same as insert(key) for callers that already know the hash of the key.
+      The hash must be equal to hasher(key).
+    */
+    std::pair<KeyType, bool> insert_with_hash(KeyType key, HashType hash) {
+        assert(key >= 0);
+        return insert(key, hash);
+    }
+
+    /*
+      Return the key in the hash set that is equivalent to the given key, or
+      -1 if the hash set contains no such key.
+    */
+    KeyType find(KeyType key) const {
+        assert(key >= 0);
+        return find_equal_key(key, hasher(key));
+    }
+
+    /*
+      Start loading the buckets for the given hash into the cache. Calling
+      this for a batch of keys before inserting them lets the memory
+      accesses of the batch overlap.
+    */
+    void prefetch(HashType hash) const {
+#if defined(__GNUC__)
+        __builtin_prefetch(&buckets[get_bucket(hash)]);
+#else
+        utils::unused_variable(hash);
+#endif
+    }
+
     void dump() const {
         int num_buckets = capacity();
         std::cout << "[";
@@ -0,0 +1,94 @@
+#include "mapped_segment_pool.h"
+
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace mapped_segment_pool {
+// Large chunks keep the number of mappings far below the limit of the OS.
+static const size_t CHUNK_BYTES = 64 * 1024 * 1024;
+static const size_t ALIGNMENT = 64;
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+static void exit_with_system_error(const string &what) {
+    cerr << "Error in mapped segment pool: " << what << ": "
+         << strerror(errno) << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+MappedSegmentPool::MappedSegmentPool(const string &directory)
+    : fd(-1),
+      file_size(0),
+      used_in_last_chunk(0) {
+    string path_template = directory + "/downward-states-XXXXXX";
+    vector<char> path(path_template.begin(), path_template.end());
+    path.push_back('\0');
+    fd = mkstemp(path.data());
+    if (fd == -1) {
+        exit_with_system_error("could not create file in " + directory);
+    }
+    if (unlink(path.data()) == -1) {
+        exit_with_system_error("could not unlink " + string(path.data()));
+    }
+}
+
+MappedSegmentPool::~MappedSegmentPool() {
+    for (const Chunk &chunk : chunks) {
+        munmap(chunk.data, chunk.size);
+    }
+    close(fd);
+}
+
+void MappedSegmentPool::add_chunk(size_t min_size) {
+    size_t size = max(CHUNK_BYTES, min_size);
+    off_t offset = file_size;
+    if (ftruncate(fd, offset + size) == -1) {
+        exit_with_system_error("could not grow file");
+    }
+    void *data = mmap(
+        nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+    if (data == MAP_FAILED) {
+        exit_with_system_error("could not map file");
+    }
+    chunks.push_back({static_cast<char *>(data), size});
+    file_size += size;
+    used_in_last_chunk = 0;
+}
+#else
+MappedSegmentPool::MappedSegmentPool(const string &)
+    : fd(-1),
+      file_size(0),
+      used_in_last_chunk(0) {
+    cerr << "Mapped segment pools are not supported on this platform." << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+}
+
+MappedSegmentPool::~MappedSegmentPool() {
+}
+
+void MappedSegmentPool::add_chunk(size_t) {
+}
+#endif
+
+void *MappedSegmentPool::allocate(size_t num_bytes) {
+    size_t aligned_bytes = (num_bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    if (chunks.empty() ||
+        used_in_last_chunk + aligned_bytes > chunks.back().size) {
+        add_chunk(aligned_bytes);
+    }
+    void *result = chunks.back().data + used_in_last_chunk;
+    used_in_last_chunk += aligned_bytes;
+    return result;
+}
+}
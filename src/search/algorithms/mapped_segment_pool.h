@@ -0,0 +1,132 @@
+#ifndef ALGORITHMS_MAPPED_SEGMENT_POOL_H
+#define ALGORITHMS_MAPPED_SEGMENT_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+  MappedSegmentPool hands out memory that is backed by a temporary file
+  instead of anonymous memory. The operating system writes dirty pages of
+  the file back to disk and drops them from RAM when memory gets scarce, so
+  rarely accessed data (e.g., the states and search nodes of closed parts of
+  the search space) migrates to disk while frequently accessed data stays in
+  the page cache. This trades disk bandwidth for problem size.
+
+  Memory is mapped in large chunks and handed out with a bump pointer. It is
+  never reused and only released when the pool is destroyed, which matches
+  how SegmentedVector and SegmentedArrayVector allocate their segments.
+
+  Note that mapped memory counts toward the address space of the process.
+  The memory limit therefore has to be enforced on the resident set size
+  (e.g., with cgroups) rather than on the address space for the pool to be
+  useful.
+
+  MappedSegmentAllocator is an allocator for the segmented vectors that
+  allocates from a given pool or, if it has no pool, from the heap.
+*/
+namespace mapped_segment_pool {
+class MappedSegmentPool {
+    struct Chunk {
+        char *data;
+        std::size_t size;
+    };
+
+    int fd;
+    std::size_t file_size;
+    std::vector<Chunk> chunks;
+    std::size_t used_in_last_chunk;
+
+    void add_chunk(std::size_t min_size);
+public:
+    /*
+      Creates the temporary file in the given directory. The file is
+      unlinked right away, so it disappears when the process terminates.
+    */
+    explicit MappedSegmentPool(const std::string &directory);
+    ~MappedSegmentPool();
+
+    MappedSegmentPool(const MappedSegmentPool &) = delete;
+    MappedSegmentPool &operator=(const MappedSegmentPool &) = delete;
+
+    void *allocate(std::size_t num_bytes);
+
+    std::size_t get_mapped_bytes() const {
+        return file_size;
+    }
+};
+
+
+template<typename T>
+class MappedSegmentAllocator {
+    template<typename U>
+    friend class MappedSegmentAllocator;
+
+    std::shared_ptr<MappedSegmentPool> pool;
+public:
+    using value_type = T;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using reference = T &;
+    using const_reference = const T &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template<typename U>
+    struct rebind {
+        using other = MappedSegmentAllocator<U>;
+    };
+
+    MappedSegmentAllocator() = default;
+
+    explicit MappedSegmentAllocator(
+        const std::shared_ptr<MappedSegmentPool> &pool)
+        : pool(pool) {
+    }
+
+    template<typename U>
+    MappedSegmentAllocator(const MappedSegmentAllocator<U> &other)
+        : pool(other.pool) {
+    }
+
+    T *allocate(std::size_t n) {
+        if (pool) {
+            return static_cast<T *>(pool->allocate(n * sizeof(T)));
+        } else {
+            return std::allocator<T>().allocate(n);
+        }
+    }
+
+    void deallocate(T *p, std::size_t n) {
+        // Memory from the pool is released together with the pool.
+        if (!pool) {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    template<typename U, typename ... Args>
+    void construct(U *p, Args && ... args) {
+        ::new(static_cast<void *>(p))U(std::forward<Args>(args) ...);
+    }
+
+    template<typename U>
+    void destroy(U *p) {
+        p->~U();
+    }
+
+    template<typename U>
+    bool operator==(const MappedSegmentAllocator<U> &other) const {
+        return pool == other.pool;
+    }
+
+    template<typename U>
+    bool operator!=(const MappedSegmentAllocator<U> &other) const {
+        return pool != other.pool;
+    }
+};
+}
+
+#endif
@@ -22,13 +22,15 @@ using namespace std;
 
 namespace cegar {
 
-Abstraction::Abstraction(const shared_ptr<AbstractTask> &task, bool debug)
+Abstraction::Abstraction(
+    const shared_ptr<AbstractTask> &task, bool store_loops, bool debug)
     : task(task),
       concrete_initial_state(TaskProxy(*task).get_initial_state()),
       goal_facts(task_properties::get_fact_pairs(TaskProxy(*task).get_goals())),
       refinement_hierarchy(utils::make_unique_ptr<RefinementHierarchy>(task)),
       split_tree(utils::make_unique_ptr<SplitTree>(task)),
-      transition_system(utils::make_unique_ptr<TransitionSystem>(TaskProxy(*task).get_operators())),
+      transition_system(utils::make_unique_ptr<TransitionSystem>(
+                            TaskProxy(*task).get_operators(), store_loops)),
       debug(debug) {
     initialize_trivial_abstraction(get_domain_sizes(TaskProxy(*task)));
 }
@@ -58,19 +60,11 @@ const TransitionSystem &Abstraction::get_transition_system() const {
 
 unique_ptr<RefinementHierarchy> Abstraction::extract_refinement_hierarchy() {
     assert(refinement_hierarchy);
+    // The abstraction won't be refined anymore, so we can flatten the DAG.
+    refinement_hierarchy->compile();
     return move(refinement_hierarchy);
 }
 
-// ____________________________________________________________________________
-vector<Transitions> Abstraction::extract_outgoing() {
-    return move(transition_system->extract_outgoing());
-}
-
-// ____________________________________________________________________________
-vector<Transitions> Abstraction::extract_incoming() {
-    return move(transition_system->extract_incoming());
-}
-
 // ____________________________________________________________________________
 vector<Loops> Abstraction::extract_loops() {
     return move(transition_system->extract_loops());
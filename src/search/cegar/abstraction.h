@@ -51,7 +51,8 @@ class Abstraction {
     void initialize_trivial_abstraction(const std::vector<int> &domain_sizes);
 
 public:
-    Abstraction(const std::shared_ptr<AbstractTask> &task, bool debug);
+    Abstraction(
+        const std::shared_ptr<AbstractTask> &task, bool store_loops, bool debug);
 
     virtual ~Abstraction();
 
@@ -66,8 +67,6 @@ public:
     // After CEGAR has run we can safely extract this information 
     // to convert into context split abstraction
     std::unique_ptr<RefinementHierarchy> extract_refinement_hierarchy();
-    std::vector<Transitions> extract_outgoing();
-    std::vector<Transitions> extract_incoming();
     std::vector<Loops> extract_loops();
     std::unique_ptr<SplitTree> extract_split_tree();
     std::unique_ptr<TransitionSystem> extract_transition_system();
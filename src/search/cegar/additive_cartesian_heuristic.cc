@@ -29,9 +29,11 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
         subtask_generators,
         opts.get<int>("max_states"),
         opts.get<int>("max_transitions"),
+        opts.get<int>("max_flaws"),
         opts.get<double>("max_time"),
         opts.get<bool>("use_general_costs"),
         static_cast<PickSplit>(opts.get<int>("pick")),
+        opts.get<int>("num_threads"),
         *rng,
         opts.get<bool>("debug"));
     return cost_saturation.generate_heuristic_functions(
@@ -41,27 +43,43 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
 AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
     const options::Options &opts)
     : Heuristic(opts),
-      heuristic_functions(generate_heuristic_functions(opts)) {
-}
-
-int AdditiveCartesianHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
-    return compute_heuristic(state);
+      heuristic_functions(generate_heuristic_functions(opts)),
+      use_packed_state_views(true) {
+    for (const CartesianHeuristicFunction &function : heuristic_functions) {
+        if (function.does_convert_state_values(task.get())) {
+            use_packed_state_views = false;
+        }
+    }
 }
 
-int AdditiveCartesianHeuristic::compute_heuristic(const State &state) {
+template<typename StateType>
+static int compute_sum_of_values(
+    const vector<CartesianHeuristicFunction> &heuristic_functions,
+    const StateType &state) {
     int sum_h = 0;
     for (const CartesianHeuristicFunction &function : heuristic_functions) {
         int value = function.get_value(state);
         assert(value >= 0);
         if (value == INF)
-            return DEAD_END;
+            return INF;
         sum_h += value;
     }
     assert(sum_h >= 0);
     return sum_h;
 }
 
+int AdditiveCartesianHeuristic::compute_heuristic(const GlobalState &global_state) {
+    int h;
+    if (use_packed_state_views) {
+        h = compute_sum_of_values(
+            heuristic_functions, convert_global_state_to_view(global_state));
+    } else {
+        h = compute_sum_of_values(
+            heuristic_functions, convert_global_state(global_state));
+    }
+    return (h == INF) ? DEAD_END : h;
+}
+
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis(
         "Additive CEGAR heuristic",
@@ -120,6 +138,15 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         " all abstractions",
         "1000000",
         Bounds("0", "infinity"));
+    parser.add_option<int>(
+        "max_flaws",
+        "maximum number of flaws that are collected from each abstract "
+        "solution and refined before searching for the next abstract "
+        "solution. Flaws are collected in pairwise different abstract "
+        "states along the solution. With max_flaws=1 we refine only the "
+        "first flaw of each abstract solution.",
+        "1",
+        Bounds("1", "infinity"));
     parser.add_option<double>(
         "max_time",
         "maximum time in seconds for building abstractions",
@@ -139,6 +166,14 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "use_general_costs",
         "allow negative costs in cost partitioning",
         "true");
+    parser.add_option<int>(
+        "num_threads",
+        "number of threads for building abstractions concurrently. With more "
+        "than one thread, the abstractions of num_threads subtasks are "
+        "refined in parallel against a snapshot of the remaining costs and "
+        "saturated in subtask order afterwards.",
+        "1",
+        Bounds("1", "infinity"));
     parser.add_option<bool>(
         "debug",
         "print debugging output",
@@ -14,8 +14,8 @@ class CartesianHeuristicFunction;
 */
 class AdditiveCartesianHeuristic : public Heuristic {
     const std::vector<CartesianHeuristicFunction> heuristic_functions;
-
-    int compute_heuristic(const State &state);
+    // True if no function needs to convert the states of our task.
+    bool use_packed_state_views;
 
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
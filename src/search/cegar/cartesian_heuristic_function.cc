@@ -2,6 +2,9 @@
 
 #include "refinement_hierarchy.h"
 
+#include "../abstract_task.h"
+#include "../packed_state_view.h"
+
 #include "../utils/collections.h"
 
 using namespace std;
@@ -19,4 +22,16 @@ int CartesianHeuristicFunction::get_value(const State &state) const {
     assert(utils::in_bounds(abstract_state_id, h_values));
     return h_values[abstract_state_id];
 }
+
+int CartesianHeuristicFunction::get_value(const PackedStateView &state) const {
+    int abstract_state_id = refinement_hierarchy->get_abstract_state_id(state);
+    assert(utils::in_bounds(abstract_state_id, h_values));
+    return h_values[abstract_state_id];
+}
+
+bool CartesianHeuristicFunction::does_convert_state_values(
+    const AbstractTask *ancestor_task) const {
+    return refinement_hierarchy->get_task()->does_convert_state_values(
+        ancestor_task);
+}
 }
@@ -4,6 +4,8 @@
 #include <memory>
 #include <vector>
 
+class AbstractTask;
+class PackedStateView;
 class State;
 
 namespace cegar {
@@ -26,6 +28,14 @@ public:
     CartesianHeuristicFunction(CartesianHeuristicFunction &&) = default;
 
     int get_value(const State &state) const;
+
+    /*
+      Only valid if does_convert_state_values(task) returns false for the
+      task of the viewed state.
+    */
+    int get_value(const PackedStateView &state) const;
+
+    bool does_convert_state_values(const AbstractTask *ancestor_task) const;
 };
 }
 
@@ -17,6 +17,7 @@
 #include <cassert>
 #include <iostream>
 #include <unordered_map>
+#include <unordered_set>
 
 using namespace std;
 
@@ -83,20 +84,24 @@ CEGAR::CEGAR(
     const shared_ptr<AbstractTask> &task,
     int max_states,
     int max_non_looping_transitions,
+    int max_flaws,
     double max_time,
     PickSplit pick,
+    bool store_loops,
     utils::RandomNumberGenerator &rng,
     bool debug)
     : task_proxy(*task),
       domain_sizes(get_domain_sizes(task_proxy)),
       max_states(max_states),
       max_non_looping_transitions(max_non_looping_transitions),
+      max_flaws(max_flaws),
       split_selector(task, pick),
-      abstraction(utils::make_unique_ptr<Abstraction>(task, debug)),
+      abstraction(utils::make_unique_ptr<Abstraction>(task, store_loops, debug)),
       abstract_search(task_properties::get_operator_costs(TaskProxy(*tasks::g_root_task))),
       timer(max_time),
       debug(debug) {
     assert(max_states >= 1);
+    assert(max_flaws >= 1);
     utils::g_log << "Start building abstraction." << endl;
     cout << "Maximum number of states: " << max_states << endl;
     cout << "Maximum number of transitions: "
@@ -188,25 +193,34 @@ void CEGAR::refinement_loop(utils::RandomNumberGenerator &rng) {
         }
 
         find_flaw_timer.resume();
-        unique_ptr<Flaw> flaw = find_flaw(*solution);
+        vector<unique_ptr<Flaw>> flaws;
+        if (max_flaws == 1) {
+            unique_ptr<Flaw> flaw = find_flaw(*solution);
+            if (flaw)
+                flaws.push_back(move(flaw));
+        } else {
+            flaws = find_flaws(*solution);
+        }
         find_flaw_timer.stop();
-        if (!flaw) {
+        if (flaws.empty()) {
             cout << "Found concrete solution during refinement." << endl;
             break;
         }
 
+        /*
+          All flaws belong to different abstract states, so splitting one
+          state leaves the states of the remaining flaws untouched.
+        */
         refine_timer.resume();
-        const AbstractState &abstract_state = flaw->current_abstract_state;
-        int state_id = abstract_state.get_id();
-        vector<Split> splits = flaw->get_possible_splits();
-        const Split &split = split_selector.pick_split(abstract_state, splits, rng);
-        auto new_state_ids = abstraction->refine(abstract_state, split.var_id, split.values);
-        // Since h-values only increase we can assign the h-value to the children.
-        abstract_search.copy_h_value_to_children(
-            state_id, new_state_ids.first, new_state_ids.second);
+        int num_states_before = abstraction->get_num_states();
+        for (size_t i = 0; i < flaws.size(); ++i) {
+            if (i > 0 && !may_keep_refining())
+                break;
+            refine(*flaws[i], rng);
+        }
         refine_timer.stop();
 
-        if (abstraction->get_num_states() % 1000 == 0) {
+        if (abstraction->get_num_states() / 1000 > num_states_before / 1000) {
             utils::g_log << abstraction->get_num_states() << "/" << max_states << " states, "
                          << abstraction->get_transition_system().get_num_non_loops() << "/"
                          << max_non_looping_transitions << " transitions" << endl;
@@ -217,6 +231,17 @@ void CEGAR::refinement_loop(utils::RandomNumberGenerator &rng) {
     cout << "Time for splitting states: " << refine_timer << endl;
 }
 
+void CEGAR::refine(const Flaw &flaw, utils::RandomNumberGenerator &rng) {
+    const AbstractState &abstract_state = flaw.current_abstract_state;
+    int state_id = abstract_state.get_id();
+    vector<Split> splits = flaw.get_possible_splits();
+    const Split &split = split_selector.pick_split(abstract_state, splits, rng);
+    auto new_state_ids = abstraction->refine(abstract_state, split.var_id, split.values);
+    // Since h-values only increase we can assign the h-value to the children.
+    abstract_search.copy_h_value_to_children(
+        state_id, new_state_ids.first, new_state_ids.second);
+}
+
 unique_ptr<Flaw> CEGAR::find_flaw(const Solution &solution) {
     if (debug)
         cout << "Check solution:" << endl;
@@ -271,6 +296,75 @@ unique_ptr<Flaw> CEGAR::find_flaw(const Solution &solution) {
     }
 }
 
+vector<unique_ptr<Flaw>> CEGAR::find_flaws(const Solution &solution) {
+    vector<unique_ptr<Flaw>> flaws;
+    unordered_set<int> flawed_states;
+    auto add_flaw = [&](
+        const State &concrete_state, const AbstractState &abstract_state,
+        CartesianSet &&desired_cartesian_set) {
+        if (flawed_states.insert(abstract_state.get_id()).second) {
+            flaws.push_back(utils::make_unique_ptr<Flaw>(
+                State(concrete_state), abstract_state, move(desired_cartesian_set)));
+        }
+    };
+
+    const AbstractState *abstract_state = &abstraction->get_initial_state();
+    State concrete_state = task_proxy.get_initial_state();
+    assert(abstract_state->includes(concrete_state));
+
+    for (const Transition &step : solution) {
+        if (static_cast<int>(flaws.size()) >= max_flaws ||
+            !utils::extra_memory_padding_is_reserved())
+            return flaws;
+        OperatorProxy op = task_proxy.get_operators()[step.op_id];
+        const AbstractState *next_abstract_state = &abstraction->get_state(step.target_id);
+        if (!task_properties::is_applicable(op, concrete_state)) {
+            add_flaw(
+                concrete_state, *abstract_state,
+                get_cartesian_set(domain_sizes, op.get_preconditions()));
+            /*
+              The abstract transition exists, so the preconditions are
+              consistent with the abstract state and the repaired state
+              still belongs to it.
+            */
+            vector<int> values = concrete_state.get_values();
+            for (FactProxy precondition : op.get_preconditions()) {
+                FactPair fact = precondition.get_pair();
+                values[fact.var] = fact.value;
+            }
+            concrete_state = task_proxy.create_state(move(values));
+            assert(abstract_state->includes(concrete_state));
+        }
+        State next_concrete_state = concrete_state.get_successor(op);
+        if (!next_abstract_state->includes(next_concrete_state)) {
+            add_flaw(
+                concrete_state, *abstract_state, next_abstract_state->regress(op));
+            // Continue with a concrete state in the next abstract state.
+            vector<int> values = next_concrete_state.get_values();
+            for (size_t var = 0; var < values.size(); ++var) {
+                if (!next_abstract_state->contains(var, values[var])) {
+                    int value = 0;
+                    while (!next_abstract_state->contains(var, value))
+                        ++value;
+                    values[var] = value;
+                }
+            }
+            next_concrete_state = task_proxy.create_state(move(values));
+            assert(next_abstract_state->includes(next_concrete_state));
+        }
+        abstract_state = next_abstract_state;
+        concrete_state = move(next_concrete_state);
+    }
+    assert(abstraction->get_goals().count(abstract_state->get_id()));
+    if (static_cast<int>(flaws.size()) < max_flaws &&
+        !task_properties::is_goal_state(task_proxy, concrete_state)) {
+        add_flaw(
+            concrete_state, *abstract_state,
+            get_cartesian_set(domain_sizes, task_proxy.get_goals()));
+    }
+    return flaws;
+}
+
 void CEGAR::print_statistics() {
     abstraction->print_statistics();
     int init_id = abstraction->get_initial_state().get_id();
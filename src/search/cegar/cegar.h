@@ -31,6 +31,7 @@ class CEGAR {
     const std::vector<int> domain_sizes;
     const int max_states;
     const int max_non_looping_transitions;
+    const int max_flaws;
     const SplitSelector split_selector;
 
     std::unique_ptr<Abstraction> abstraction;
@@ -57,6 +58,18 @@ class CEGAR {
        first encountered flaw or nullptr if there is no flaw. */
     std::unique_ptr<Flaw> find_flaw(const Solution &solution);
 
+    /*
+      Trace the abstract solution and collect up to max_flaws flaws in
+      pairwise different abstract states. After a flaw, we continue
+      tracing from a concrete state that is consistent with the next
+      abstract state of the solution. The first flaw is the one that
+      find_flaw() returns. Return an empty vector if there is no flaw.
+    */
+    std::vector<std::unique_ptr<Flaw>> find_flaws(const Solution &solution);
+
+    // Split the abstract state of the flaw.
+    void refine(const Flaw &flaw, utils::RandomNumberGenerator &rng);
+
     // Build abstraction.
     void refinement_loop(utils::RandomNumberGenerator &rng);
 
@@ -67,8 +80,10 @@ public:
         const std::shared_ptr<AbstractTask> &task,
         int max_states,
         int max_non_looping_transitions,
+        int max_flaws,
         double max_time,
         PickSplit pick,
+        bool store_loops,
         utils::RandomNumberGenerator &rng,
         bool debug);
     ~CEGAR();
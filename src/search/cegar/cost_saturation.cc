@@ -14,9 +14,12 @@
 #include "../utils/countdown_timer.h"
 #include "../utils/logging.h"
 #include "../utils/memory.h"
+#include "../utils/rng.h"
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
+#include <thread>
 
 using namespace std;
 
@@ -85,17 +88,21 @@ CostSaturation::CostSaturation(
     const vector<shared_ptr<SubtaskGenerator>> &subtask_generators,
     int max_states,
     int max_non_looping_transitions,
+    int max_flaws,
     double max_time,
     bool use_general_costs,
     PickSplit pick_split,
+    int num_threads,
     utils::RandomNumberGenerator &rng,
     bool debug)
     : subtask_generators(subtask_generators),
       max_states(max_states),
       max_non_looping_transitions(max_non_looping_transitions),
+      max_flaws(max_flaws),
       max_time(max_time),
       use_general_costs(use_general_costs),
       pick_split(pick_split),
+      num_threads(num_threads),
       rng(rng),
       debug(debug),
       num_abstractions(0),
@@ -131,7 +138,11 @@ vector<CartesianHeuristicFunction> CostSaturation::generate_heuristic_functions(
     utils::reserve_extra_memory_padding(memory_padding_in_mb);
     for (const shared_ptr<SubtaskGenerator> &subtask_generator : subtask_generators) {
         SharedTasks subtasks = subtask_generator->get_subtasks(task);
-        build_abstractions(subtasks, timer, should_abort);
+        if (num_threads > 1) {
+            build_abstractions_in_parallel(subtasks, timer, should_abort);
+        } else {
+            build_abstractions(subtasks, timer, should_abort);
+        }
         if (should_abort())
             break;
     }
@@ -187,6 +198,34 @@ bool CostSaturation::state_is_dead_end(const State &state) const {
     return false;
 }
 
+void CostSaturation::add_abstraction(
+    unique_ptr<Abstraction> abstraction, const vector<int> &costs) {
+    ++num_abstractions;
+    num_states += abstraction->get_num_states();
+    num_non_looping_transitions += abstraction->get_transition_system().get_num_non_loops();
+    assert(num_states <= max_states);
+
+    vector<int> init_distances = compute_distances(
+        abstraction->get_transition_system().get_outgoing_transitions(),
+        costs,
+        {abstraction->get_initial_state().get_id()});
+    vector<int> goal_distances = compute_distances(
+        abstraction->get_transition_system().get_incoming_transitions(),
+        costs,
+        abstraction->get_goals());
+    vector<int> saturated_costs = compute_saturated_costs(
+        abstraction->get_transition_system(),
+        init_distances,
+        goal_distances,
+        use_general_costs);
+
+    heuristic_functions.emplace_back(
+        abstraction->extract_refinement_hierarchy(),
+        move(goal_distances));
+
+    reduce_remaining_costs(saturated_costs);
+}
+
 void CostSaturation::build_abstractions(
     const vector<shared_ptr<AbstractTask>> &subtasks,
     const utils::CountdownTimer &timer,
@@ -196,42 +235,22 @@ void CostSaturation::build_abstractions(
         subtask = get_remaining_costs_task(subtask);
 
         assert(num_states < max_states);
+        // Self-loops are only needed for computing general saturated costs.
         CEGAR cegar(
             subtask,
             max(1, (max_states - num_states) / rem_subtasks),
             max(1, (max_non_looping_transitions - num_non_looping_transitions) /
                 rem_subtasks),
+            max_flaws,
             timer.get_remaining_time() / rem_subtasks,
             pick_split,
+            use_general_costs,
             rng,
             debug);
 
-        unique_ptr<Abstraction> abstraction = cegar.extract_abstraction();
-        ++num_abstractions;
-        num_states += abstraction->get_num_states();
-        num_non_looping_transitions += abstraction->get_transition_system().get_num_non_loops();
-        assert(num_states <= max_states);
-
-        vector<int> costs = task_properties::get_operator_costs(TaskProxy(*subtask));
-        vector<int> init_distances = compute_distances(
-            abstraction->get_transition_system().get_outgoing_transitions(),
-            costs,
-            {abstraction->get_initial_state().get_id()});
-        vector<int> goal_distances = compute_distances(
-            abstraction->get_transition_system().get_incoming_transitions(),
-            costs,
-            abstraction->get_goals());
-        vector<int> saturated_costs = compute_saturated_costs(
-            abstraction->get_transition_system(),
-            init_distances,
-            goal_distances,
-            use_general_costs);
-
-        heuristic_functions.emplace_back(
-            abstraction->extract_refinement_hierarchy(),
-            move(goal_distances));
-
-        reduce_remaining_costs(saturated_costs);
+        add_abstraction(
+            cegar.extract_abstraction(),
+            task_properties::get_operator_costs(TaskProxy(*subtask)));
 
         if (should_abort())
             break;
@@ -240,6 +259,97 @@ void CostSaturation::build_abstractions(
     }
 }
 
+void CostSaturation::build_abstractions_in_parallel(
+    const vector<shared_ptr<AbstractTask>> &subtasks,
+    const utils::CountdownTimer &timer,
+    function<bool()> should_abort) {
+    int num_subtasks = subtasks.size();
+    for (int batch_start = 0; batch_start < num_subtasks;
+         batch_start += num_threads) {
+        int rem_subtasks = num_subtasks - batch_start;
+        int batch_size = min(num_threads, rem_subtasks);
+        int rem_batches = (rem_subtasks + num_threads - 1) / num_threads;
+
+        /*
+          Each abstraction of the batch gets the state and transition budget
+          that the sequential mode would assign to the first subtask of the
+          batch. Since the abstractions are built concurrently, each of them
+          may use the time that remains for the whole batch.
+        */
+        assert(num_states < max_states);
+        int batch_max_states = max(1, (max_states - num_states) / rem_subtasks);
+        int batch_max_transitions = max(
+            1, (max_non_looping_transitions - num_non_looping_transitions) /
+            rem_subtasks);
+        double batch_max_time = timer.get_remaining_time() / rem_batches;
+
+        /*
+          Each thread only writes to its own slot in "abstractions" and uses
+          its own random number generator, so the threads never need to
+          synchronize. We seed the generators in a fixed order to keep runs
+          reproducible.
+        */
+        vector<unique_ptr<Abstraction>> abstractions(batch_size);
+        vector<unique_ptr<utils::RandomNumberGenerator>> rngs;
+        rngs.reserve(batch_size);
+        for (int i = 0; i < batch_size; ++i) {
+            rngs.push_back(utils::make_unique_ptr<utils::RandomNumberGenerator>(
+                rng(numeric_limits<int>::max())));
+        }
+        /*
+          PerTaskInformation objects such as the global state packers are
+          not thread-safe. Heuristics for tasks that convert state values
+          (e.g., the additive heuristic of the split selector on a domain
+          abstracted task) look up the packer of their task, so we create
+          the packers here. We also keep the snapshot tasks alive until all
+          threads have finished, so that their packers are destroyed on
+          this thread as well.
+        */
+        vector<shared_ptr<AbstractTask>> snapshot_tasks;
+        snapshot_tasks.reserve(batch_size);
+        for (int i = 0; i < batch_size; ++i) {
+            shared_ptr<AbstractTask> subtask = subtasks[batch_start + i];
+            snapshot_tasks.push_back(get_remaining_costs_task(subtask));
+            task_properties::g_state_packers[TaskProxy(*snapshot_tasks.back())];
+        }
+
+        vector<thread> threads;
+        threads.reserve(batch_size);
+        for (int i = 0; i < batch_size; ++i) {
+            shared_ptr<AbstractTask> snapshot_task = snapshot_tasks[i];
+            threads.emplace_back(
+                [this, i, snapshot_task, batch_max_states, batch_max_transitions,
+                 batch_max_time, &abstractions, &rngs]() {
+                    CEGAR cegar(
+                        snapshot_task,
+                        batch_max_states,
+                        batch_max_transitions,
+                        max_flaws,
+                        batch_max_time,
+                        pick_split,
+                        use_general_costs,
+                        *rngs[i],
+                        debug);
+                    abstractions[i] = cegar.extract_abstraction();
+                });
+        }
+        for (thread &worker : threads) {
+            worker.join();
+        }
+
+        /*
+          Saturate in the intended order. Refinement only used the snapshot,
+          so we compute distances with the costs that actually remain once
+          the previous abstractions have been saturated.
+        */
+        for (unique_ptr<Abstraction> &abstraction : abstractions) {
+            add_abstraction(move(abstraction), remaining_costs);
+            if (should_abort())
+                return;
+        }
+    }
+}
+
 void CostSaturation::print_statistics(utils::Duration init_time) const {
     utils::g_log << "Done initializing additive Cartesian heuristic" << endl;
     cout << "Time for initializing additive Cartesian heuristic: "
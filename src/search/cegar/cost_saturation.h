@@ -14,6 +14,7 @@ class RandomNumberGenerator;
 }
 
 namespace cegar {
+class Abstraction;
 class CartesianHeuristicFunction;
 class SubtaskGenerator;
 
@@ -23,14 +24,22 @@ class SubtaskGenerator;
   RefinementHierarchies from Abstractions to
   CartesianHeuristicFunctions, allow extracting
   CartesianHeuristicFunctions into AdditiveCartesianHeuristic.
+
+  With num_threads > 1, the subtasks are processed in batches of
+  num_threads subtasks. All abstractions of a batch are refined
+  concurrently against a snapshot of the remaining costs. Afterwards, we
+  saturate the costs in the original subtask order, which yields the same
+  kind of saturated cost partitioning as the sequential mode.
 */
 class CostSaturation {
     const std::vector<std::shared_ptr<SubtaskGenerator>> subtask_generators;
     const int max_states;
     const int max_non_looping_transitions;
+    const int max_flaws;
     const double max_time;
     const bool use_general_costs;
     const PickSplit pick_split;
+    const int num_threads;
     utils::RandomNumberGenerator &rng;
     const bool debug;
 
@@ -45,10 +54,16 @@ class CostSaturation {
     std::shared_ptr<AbstractTask> get_remaining_costs_task(
         std::shared_ptr<AbstractTask> &parent) const;
     bool state_is_dead_end(const State &state) const;
+    void add_abstraction(
+        std::unique_ptr<Abstraction> abstraction, const std::vector<int> &costs);
     void build_abstractions(
         const std::vector<std::shared_ptr<AbstractTask>> &subtasks,
         const utils::CountdownTimer &timer,
         std::function<bool()> should_abort);
+    void build_abstractions_in_parallel(
+        const std::vector<std::shared_ptr<AbstractTask>> &subtasks,
+        const utils::CountdownTimer &timer,
+        std::function<bool()> should_abort);
     void print_statistics(utils::Duration init_time) const;
 
 public:
@@ -56,9 +71,11 @@ public:
         const std::vector<std::shared_ptr<SubtaskGenerator>> &subtask_generators,
         int max_states,
         int max_non_looping_transitions,
+        int max_flaws,
         double max_time,
         bool use_general_costs,
         PickSplit pick_split,
+        int num_threads,
         utils::RandomNumberGenerator &rng,
         bool debug);
 
@@ -0,0 +1,97 @@
+#ifndef CEGAR_LOOPS_H
+#define CEGAR_LOOPS_H
+
+#include "varint.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace cegar {
+/*
+  Compact list of the operators that induce self-loops in an abstract
+  state.
+
+  Operator IDs must be added in increasing order. We only store the
+  differences between consecutive IDs and encode them as variable-length
+  integers (see varint.h). Since most abstract states loop for long runs
+  of neighbouring operators, nearly all IDs fit into a single byte
+  instead of four.
+*/
+class Loops {
+    std::vector<uint8_t> bytes;
+    int last_op_id;
+    int num_op_ids;
+
+public:
+    class const_iterator {
+        const uint8_t *pos;
+        int previous_op_id;
+
+        int decode(const uint8_t *&next) const {
+            return previous_op_id + varint::decode(next);
+        }
+
+    public:
+        const_iterator(const uint8_t *pos, int previous_op_id)
+            : pos(pos),
+              previous_op_id(previous_op_id) {
+        }
+
+        int operator*() const {
+            const uint8_t *next = pos;
+            return decode(next);
+        }
+
+        const_iterator &operator++() {
+            previous_op_id = decode(pos);
+            return *this;
+        }
+
+        bool operator==(const const_iterator &other) const {
+            return pos == other.pos;
+        }
+
+        bool operator!=(const const_iterator &other) const {
+            return pos != other.pos;
+        }
+    };
+
+    Loops()
+        : last_op_id(-1),
+          num_op_ids(0) {
+    }
+
+    void push_back(int op_id) {
+        assert(op_id > last_op_id);
+        int delta = op_id - last_op_id;
+        int old_size = bytes.size();
+        bytes.resize(old_size + varint::get_encoded_size(delta));
+        varint::encode(delta, bytes.data() + old_size);
+        last_op_id = op_id;
+        ++num_op_ids;
+    }
+
+    const_iterator begin() const {
+        return const_iterator(bytes.data(), -1);
+    }
+
+    const_iterator end() const {
+        return const_iterator(bytes.data() + bytes.size(), last_op_id);
+    }
+
+    bool empty() const {
+        return bytes.empty();
+    }
+
+    int size() const {
+        return num_op_ids;
+    }
+
+    void shrink_to_fit() {
+        bytes.shrink_to_fit();
+    }
+};
+}
+
+#endif
@@ -4,6 +4,8 @@
 
 #include "../task_proxy.h"
 
+#include <deque>
+
 using namespace std;
 
 namespace cegar {
@@ -48,7 +50,9 @@ ostream &operator<<(ostream &os, const Node &node) {
 
 
 RefinementHierarchy::RefinementHierarchy(const shared_ptr<AbstractTask> &task)
-    : task(task) {
+    : task(task),
+      compiled(false),
+      flat_root(UNDEFINED) {
     nodes.emplace_back(0);
 }
 
@@ -63,6 +67,7 @@ NodeID RefinementHierarchy::add_node(int state_id) {
 }
 
 NodeID RefinementHierarchy::get_node_id(const State &state) const {
+    assert(!compiled);
     NodeID id = 0;
     while (nodes[id].is_split()) {
         const Node &node = nodes[id];
@@ -73,6 +78,7 @@ NodeID RefinementHierarchy::get_node_id(const State &state) const {
 
 pair<NodeID, NodeID> RefinementHierarchy::split(
     NodeID node_id, int var, const vector<int> &values, int left_state_id, int right_state_id) {
+    assert(!compiled);
     NodeID helper_id = node_id;
     NodeID right_child_id = add_node(right_state_id);
     for (int value : values) {
@@ -83,10 +89,78 @@ pair<NodeID, NodeID> RefinementHierarchy::split(
     return make_pair(helper_id, right_child_id);
 }
 
+void RefinementHierarchy::compile() {
+    assert(!compiled);
+    VariablesProxy variables = TaskProxy(*task).get_variables();
+    // Offsets of the jump tables of all nodes that start a table.
+    vector<int> offsets(nodes.size(), UNDEFINED);
+    deque<NodeID> queue;
+    auto get_entry = [&](NodeID id) -> int {
+        const Node &node = nodes[id];
+        if (!node.is_split()) {
+            return ~node.get_state_id();
+        }
+        if (offsets[id] == UNDEFINED) {
+            offsets[id] = flat_nodes.size();
+            int domain_size = variables[node.get_var()].get_domain_size();
+            flat_nodes.resize(flat_nodes.size() + 1 + domain_size, UNDEFINED);
+            queue.push_back(id);
+        }
+        return offsets[id];
+    };
+
+    flat_root = get_entry(0);
+    while (!queue.empty()) {
+        NodeID id = queue.front();
+        queue.pop_front();
+        int var = nodes[id].get_var();
+        int offset = offsets[id];
+        flat_nodes[offset] = var;
+        int domain_size = variables[var].get_domain_size();
+        for (int value = 0; value < domain_size; ++value) {
+            NodeID child_id = id;
+            while (nodes[child_id].is_split() && nodes[child_id].get_var() == var) {
+                child_id = nodes[child_id].get_child(value);
+            }
+            // Compute the entry first since it may grow flat_nodes.
+            int entry = get_entry(child_id);
+            flat_nodes[offset + 1 + value] = entry;
+        }
+    }
+    flat_nodes.shrink_to_fit();
+    vector<Node>().swap(nodes);
+    compiled = true;
+}
+
 int RefinementHierarchy::get_abstract_state_id(const State &state) const {
     TaskProxy subtask_proxy(*task);
     State subtask_state = subtask_proxy.convert_ancestor_state(state);
+    if (compiled) {
+        const vector<int> &values = subtask_state.get_values();
+        int entry = flat_root;
+        while (entry >= 0) {
+            entry = flat_nodes[entry + 1 + values[flat_nodes[entry]]];
+        }
+        return ~entry;
+    }
     return nodes[get_node_id(subtask_state)].get_state_id();
 }
 
+int RefinementHierarchy::get_abstract_state_id(const PackedStateView &state) const {
+    assert(state.size() == task->get_num_variables());
+    if (compiled) {
+        int entry = flat_root;
+        while (entry >= 0) {
+            entry = flat_nodes[entry + 1 + state[flat_nodes[entry]]];
+        }
+        return ~entry;
+    }
+    NodeID id = 0;
+    while (nodes[id].is_split()) {
+        const Node &node = nodes[id];
+        id = node.get_child(state[node.get_var()]);
+    }
+    return nodes[id].get_state_id();
+}
+
 }
@@ -10,6 +10,7 @@
 #include <vector>
 
 class AbstractTask;
+class PackedStateView;
 class State;
 
 namespace cegar {
@@ -27,11 +28,23 @@ class CartesianSet;
   helper nodes, see below). Leaf nodes correspond to the current
   (unsplit) states in an abstraction. The use of helper nodes makes
   this structure a directed acyclic graph (instead of a tree).
+
+  Once the abstraction is final, compile() replaces the DAG by a flat
+  array of jump tables that is laid out in breadth-first order. Each
+  table starts with the split variable, followed by one entry per value
+  of its domain. Consecutive splits over the same variable (including
+  all helper nodes of a split) collapse into a single table. An entry
+  is either the offset of the next table (>= 0) or the bitwise
+  complement of an abstract state ID (< 0).
 */
 class RefinementHierarchy {
     std::shared_ptr<AbstractTask> task;
     std::vector<Node> nodes;
 
+    bool compiled;
+    std::vector<int> flat_nodes;
+    int flat_root;
+
     NodeID add_node(int state_id);
     NodeID get_node_id(const State &state) const;
 
@@ -49,7 +62,24 @@ public:
         NodeID node_id, int var, const std::vector<int> &values,
         int left_state_id, int right_state_id);
 
+    /*
+      Build the flattened lookup representation and release the DAG.
+      Afterwards, the hierarchy can't be split anymore.
+    */
+    void compile();
+
     int get_abstract_state_id(const State &state) const;
+
+    /*
+      Faster lookup for states that don't need to be converted to the task
+      of this hierarchy, i.e., states of an ancestor task for which
+      does_convert_state_values() returns false.
+    */
+    int get_abstract_state_id(const PackedStateView &state) const;
+
+    const std::shared_ptr<AbstractTask> &get_task() const {
+        return task;
+    }
 };
 
 
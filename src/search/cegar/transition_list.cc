@@ -0,0 +1,114 @@
+#include "transition_list.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace cegar {
+TransitionListAllocator::TransitionListAllocator()
+    : slab_pos(nullptr),
+      slab_remaining(0),
+      num_reserved_bytes(0) {
+}
+
+int TransitionListAllocator::get_size_class(int num_bytes) {
+    int size_class = 0;
+    while (get_block_size(size_class) < num_bytes) {
+        ++size_class;
+    }
+    return size_class;
+}
+
+void TransitionListAllocator::free_block(uint8_t *block, int size_class) {
+    if (size_class >= static_cast<int>(free_blocks.size())) {
+        free_blocks.resize(size_class + 1, nullptr);
+    }
+    memcpy(block, &free_blocks[size_class], sizeof(uint8_t *));
+    free_blocks[size_class] = block;
+}
+
+uint8_t *TransitionListAllocator::allocate(int size_class) {
+    if (size_class < static_cast<int>(free_blocks.size()) &&
+        free_blocks[size_class]) {
+        uint8_t *block = free_blocks[size_class];
+        memcpy(&free_blocks[size_class], block, sizeof(uint8_t *));
+        return block;
+    }
+
+    int block_size = get_block_size(size_class);
+    if (block_size > SLAB_SIZE) {
+        // Huge blocks get a slab of their own.
+        slabs.emplace_back(new uint8_t[block_size]);
+        num_reserved_bytes += block_size;
+        return slabs.back().get();
+    }
+    if (block_size > slab_remaining) {
+        /* Split the rest of the current slab into free blocks. Since all
+           sizes are powers of two, the rest is a multiple of
+           MIN_BLOCK_SIZE. */
+        while (slab_remaining > 0) {
+            int rest_class = get_size_class(slab_remaining);
+            if (get_block_size(rest_class) > slab_remaining)
+                --rest_class;
+            free_block(slab_pos, rest_class);
+            slab_pos += get_block_size(rest_class);
+            slab_remaining -= get_block_size(rest_class);
+        }
+        slabs.emplace_back(new uint8_t[SLAB_SIZE]);
+        num_reserved_bytes += SLAB_SIZE;
+        slab_pos = slabs.back().get();
+        slab_remaining = SLAB_SIZE;
+    }
+    uint8_t *block = slab_pos;
+    slab_pos += block_size;
+    slab_remaining -= block_size;
+    return block;
+}
+
+void TransitionListAllocator::deallocate(uint8_t *block, int size_class) {
+    assert(block);
+    free_block(block, size_class);
+}
+
+
+void TransitionList::reserve(
+    int min_num_bytes, TransitionListAllocator &allocator) {
+    int new_size_class = TransitionListAllocator::get_size_class(min_num_bytes);
+    uint8_t *new_bytes = allocator.allocate(new_size_class);
+    if (bytes) {
+        memcpy(new_bytes, bytes, num_bytes);
+        allocator.deallocate(bytes, size_class);
+    }
+    bytes = new_bytes;
+    size_class = new_size_class;
+}
+
+void TransitionList::remove_transitions_with_target(int target_id) {
+    /* Kept transitions keep their encoding and the write position never
+       passes the read position, so we can compact the list in place. */
+    const uint8_t *read_pos = bytes;
+    const uint8_t *end_pos = bytes + num_bytes;
+    uint8_t *write_pos = bytes;
+    while (read_pos != end_pos) {
+        int op_id = varint::decode(read_pos);
+        int transition_target_id = varint::decode(read_pos);
+        if (transition_target_id == target_id) {
+            --num_transitions;
+        } else {
+            write_pos = varint::encode(op_id, write_pos);
+            write_pos = varint::encode(transition_target_id, write_pos);
+        }
+    }
+    num_bytes = write_pos - bytes;
+}
+
+void TransitionList::clear(TransitionListAllocator &allocator) {
+    if (bytes) {
+        allocator.deallocate(bytes, size_class);
+    }
+    bytes = nullptr;
+    num_bytes = 0;
+    num_transitions = 0;
+    size_class = -1;
+}
+}
@@ -0,0 +1,183 @@
+#ifndef CEGAR_TRANSITION_LIST_H
+#define CEGAR_TRANSITION_LIST_H
+
+#include "transition.h"
+#include "varint.h"
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cegar {
+/*
+  Hands out the memory blocks of TransitionLists from large slabs.
+
+  Block sizes are powers of two and freed blocks are kept in one free
+  list per size class. Rewiring a split state therefore reuses the blocks
+  of the old transition lists instead of going through the system
+  allocator for each list. Slabs are only returned to the system when
+  the allocator is destroyed.
+*/
+class TransitionListAllocator {
+    // Smallest block size (in bytes). Free blocks store a pointer.
+    static const int MIN_BLOCK_SIZE = 16;
+    static const int SLAB_SIZE = 1 << 16;
+
+    std::vector<std::unique_ptr<uint8_t[]>> slabs;
+    uint8_t *slab_pos;
+    int slab_remaining;
+    // Free blocks of size class c are linked through their first bytes.
+    std::vector<uint8_t *> free_blocks;
+    size_t num_reserved_bytes;
+
+    void free_block(uint8_t *block, int size_class);
+
+public:
+    TransitionListAllocator();
+
+    TransitionListAllocator(const TransitionListAllocator &) = delete;
+    TransitionListAllocator &operator=(const TransitionListAllocator &) = delete;
+
+    static int get_block_size(int size_class) {
+        return MIN_BLOCK_SIZE << size_class;
+    }
+
+    // Return the smallest size class with blocks of at least num_bytes bytes.
+    static int get_size_class(int num_bytes);
+
+    uint8_t *allocate(int size_class);
+    void deallocate(uint8_t *block, int size_class);
+
+    // Bytes reserved from the system, including free blocks.
+    size_t get_num_reserved_bytes() const {
+        return num_reserved_bytes;
+    }
+};
+
+
+/*
+  Compact list of the state-changing transitions of an abstract state.
+
+  Each transition is stored as a pair of variable-length integers (see
+  varint.h) in a block of a TransitionListAllocator. Operator and state
+  IDs of all but the largest tasks and abstractions need at most three
+  bytes each, so a transition takes 2-6 instead of 8 bytes, and there is
+  no per-list allocation overhead of the system allocator.
+
+  Lists don't free their memory themselves. The owner must call clear()
+  with the allocator that filled the list or destroy the allocator.
+  Iterating yields Transition objects by value.
+*/
+class TransitionList {
+    uint8_t *bytes;
+    int num_bytes;
+    int num_transitions;
+    int size_class;
+
+    void reserve(int min_num_bytes, TransitionListAllocator &allocator);
+
+public:
+    class const_iterator {
+        const uint8_t *pos;
+
+    public:
+        explicit const_iterator(const uint8_t *pos)
+            : pos(pos) {
+        }
+
+        Transition operator*() const {
+            const uint8_t *next = pos;
+            int op_id = varint::decode(next);
+            int target_id = varint::decode(next);
+            return Transition(op_id, target_id);
+        }
+
+        const_iterator &operator++() {
+            varint::decode(pos);
+            varint::decode(pos);
+            return *this;
+        }
+
+        bool operator==(const const_iterator &other) const {
+            return pos == other.pos;
+        }
+
+        bool operator!=(const const_iterator &other) const {
+            return pos != other.pos;
+        }
+    };
+
+    TransitionList()
+        : bytes(nullptr),
+          num_bytes(0),
+          num_transitions(0),
+          size_class(-1) {
+    }
+
+    TransitionList(const TransitionList &) = delete;
+    TransitionList &operator=(const TransitionList &) = delete;
+
+    TransitionList(TransitionList &&other) noexcept
+        : bytes(other.bytes),
+          num_bytes(other.num_bytes),
+          num_transitions(other.num_transitions),
+          size_class(other.size_class) {
+        other.bytes = nullptr;
+        other.num_bytes = 0;
+        other.num_transitions = 0;
+        other.size_class = -1;
+    }
+
+    TransitionList &operator=(TransitionList &&other) noexcept {
+        assert(!bytes);
+        bytes = other.bytes;
+        num_bytes = other.num_bytes;
+        num_transitions = other.num_transitions;
+        size_class = other.size_class;
+        other.bytes = nullptr;
+        other.num_bytes = 0;
+        other.num_transitions = 0;
+        other.size_class = -1;
+        return *this;
+    }
+
+    void emplace_back(
+        int op_id, int target_id, TransitionListAllocator &allocator) {
+        int size = varint::get_encoded_size(op_id) +
+            varint::get_encoded_size(target_id);
+        if (size_class == -1 ||
+            num_bytes + size > TransitionListAllocator::get_block_size(size_class)) {
+            reserve(num_bytes + size, allocator);
+        }
+        uint8_t *pos = varint::encode(op_id, bytes + num_bytes);
+        pos = varint::encode(target_id, pos);
+        num_bytes = pos - bytes;
+        ++num_transitions;
+    }
+
+    // Remove all transitions with the given target in place.
+    void remove_transitions_with_target(int target_id);
+
+    // Remove all transitions and return the memory to the allocator.
+    void clear(TransitionListAllocator &allocator);
+
+    const_iterator begin() const {
+        return const_iterator(bytes);
+    }
+
+    const_iterator end() const {
+        return const_iterator(bytes + num_bytes);
+    }
+
+    bool empty() const {
+        return num_transitions == 0;
+    }
+
+    int size() const {
+        return num_transitions;
+    }
+};
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "../task_proxy.h"
 
 #include "../task_utils/task_properties.h"
+#include "../utils/language.h"
 
 #include <algorithm>
 #include <map>
@@ -55,6 +56,18 @@ static vector<vector<FactPair>> get_postconditions_by_operator(
     return postconditions_by_operator;
 }
 
+static vector<vector<int>> get_operators_by_var(const OperatorsProxy &ops) {
+    vector<vector<int>> operators_by_var;
+    for (OperatorProxy op : ops) {
+        for (const FactPair &fact : get_postconditions(op)) {
+            if (fact.var >= static_cast<int>(operators_by_var.size()))
+                operators_by_var.resize(fact.var + 1);
+            operators_by_var[fact.var].push_back(op.get_id());
+        }
+    }
+    return operators_by_var;
+}
+
 static int lookup_value(const vector<FactPair> &facts, int var) {
     assert(is_sorted(facts.begin(), facts.end()));
     for (const FactPair &fact : facts) {
@@ -69,17 +82,19 @@ static int lookup_value(const vector<FactPair> &facts, int var) {
 
 static void remove_transitions_with_given_target(
     Transitions &transitions, int state_id) {
-    auto new_end = remove_if(
-        transitions.begin(), transitions.end(),
-        [state_id](const Transition &t) {return t.target_id == state_id;});
-    assert(new_end != transitions.end());
-    transitions.erase(new_end, transitions.end());
+    int old_size = transitions.size();
+    transitions.remove_transitions_with_target(state_id);
+    assert(transitions.size() < old_size);
+    utils::unused_variable(old_size);
 }
 
 
-TransitionSystem::TransitionSystem(const OperatorsProxy &ops)
+TransitionSystem::TransitionSystem(const OperatorsProxy &ops, bool store_loops)
     : preconditions_by_operator(get_preconditions_by_operator(ops)),
       postconditions_by_operator(get_postconditions_by_operator(ops)),
+      store_loops(store_loops),
+      operators_by_var(
+          store_loops ? vector<vector<int>>() : get_operators_by_var(ops)),
       num_non_loops(0),
       num_loops(0) {
     add_loops_in_trivial_abstraction();
@@ -106,6 +121,8 @@ void TransitionSystem::enlarge_vectors_by_one() {
 void TransitionSystem::add_loops_in_trivial_abstraction() {
     assert(get_num_states() == 0);
     enlarge_vectors_by_one();
+    if (!store_loops)
+        return;
     int init_id = 0;
     for (int i = 0; i < get_num_operators(); ++i) {
         add_loop(init_id, i);
@@ -114,17 +131,51 @@ void TransitionSystem::add_loops_in_trivial_abstraction() {
 
 void TransitionSystem::add_transition(int src_id, int op_id, int target_id) {
     assert(src_id != target_id);
-    outgoing[src_id].emplace_back(op_id, target_id);
-    incoming[target_id].emplace_back(op_id, src_id);
+    outgoing[src_id].emplace_back(op_id, target_id, transition_list_allocator);
+    incoming[target_id].emplace_back(op_id, src_id, transition_list_allocator);
     ++num_non_loops;
 }
 
 void TransitionSystem::add_loop(int state_id, int op_id) {
+    if (!store_loops)
+        return;
     assert(utils::in_bounds(state_id, loops));
     loops[state_id].push_back(op_id);
     ++num_loops;
 }
 
+bool TransitionSystem::operator_loops_in_union(
+    int op_id, const AbstractState &v1, const AbstractState &v2, int var) const {
+    /* v1 and v2 only differ in the domain of var, so their union is
+       Cartesian and the facts of all other variables can be tested on
+       v1 alone. */
+    auto union_contains = [&](const FactPair &fact) {
+        return v1.contains(fact.var, fact.value) ||
+               (fact.var == var && v2.contains(var, fact.value));
+    };
+    for (const FactPair &fact : preconditions_by_operator[op_id]) {
+        if (!union_contains(fact))
+            return false;
+    }
+    for (const FactPair &fact : postconditions_by_operator[op_id]) {
+        if (!union_contains(fact))
+            return false;
+    }
+    return true;
+}
+
+Loops TransitionSystem::compute_loops_mentioning_var(
+    const AbstractState &v1, const AbstractState &v2, int var) const {
+    Loops result;
+    if (utils::in_bounds(var, operators_by_var)) {
+        for (int op_id : operators_by_var[var]) {
+            if (operator_loops_in_union(op_id, v1, v2, var))
+                result.push_back(op_id);
+        }
+    }
+    return result;
+}
+
 void TransitionSystem::rewire_incoming_transitions(
     const Transitions &old_incoming, const AbstractStates &states,
     const AbstractState &v1, const AbstractState &v2, int var) {
@@ -272,7 +323,8 @@ void TransitionSystem::rewire_loops(
             }
         }
     }
-    num_loops -= old_loops.size();
+    if (store_loops)
+        num_loops -= old_loops.size();
 }
 
 void TransitionSystem::rewire(
@@ -281,12 +333,12 @@ void TransitionSystem::rewire(
     // Retrieve old transitions and make space for new transitions.
     Transitions old_incoming = move(incoming[v_id]);
     Transitions old_outgoing = move(outgoing[v_id]);
-    Loops old_loops = move(loops[v_id]);
+    Loops old_loops = store_loops ? move(loops[v_id])
+                      : compute_loops_mentioning_var(v1, v2, var);
+    loops[v_id] = Loops();
     enlarge_vectors_by_one();
     int v1_id = v1.get_id();
     int v2_id = v2.get_id();
-    utils::unused_variable(v1_id);
-    utils::unused_variable(v2_id);
     assert(incoming[v1_id].empty() && outgoing[v1_id].empty() && loops[v1_id].empty());
     assert(incoming[v2_id].empty() && outgoing[v2_id].empty() && loops[v2_id].empty());
 
@@ -294,6 +346,10 @@ void TransitionSystem::rewire(
     rewire_incoming_transitions(old_incoming, states, v1, v2, var);
     rewire_outgoing_transitions(old_outgoing, states, v1, v2, var);
     rewire_loops(old_loops, v1, v2, var);
+    old_incoming.clear(transition_list_allocator);
+    old_outgoing.clear(transition_list_allocator);
+    loops[v1_id].shrink_to_fit();
+    loops[v2_id].shrink_to_fit();
 }
 
 const vector<Transitions> &TransitionSystem::get_incoming_transitions() const {
@@ -305,6 +361,7 @@ const vector<Transitions> &TransitionSystem::get_outgoing_transitions() const {
 }
 
 const vector<Loops> &TransitionSystem::get_loops() const {
+    assert(store_loops);
     return loops;
 }
 
@@ -338,19 +395,19 @@ void TransitionSystem::print_statistics() const {
     assert(total_outgoing_transitions == total_incoming_transitions);
     assert(get_num_loops() == total_loops);
     assert(get_num_non_loops() == total_outgoing_transitions);
-    cout << "Looping transitions: " << total_loops << endl;
+    if (store_loops) {
+        cout << "Looping transitions: " << total_loops << endl;
+    } else {
+        cout << "Looping transitions: not stored" << endl;
+    }
     cout << "Non-looping transitions: " << total_outgoing_transitions << endl;
-}
-
-std::vector<Transitions> TransitionSystem::extract_outgoing() {
-    return move(outgoing);
-}
-
-std::vector<Transitions> TransitionSystem::extract_incoming() {
-    return move(incoming);
+    cout << "Memory for non-looping transitions: "
+         << transition_list_allocator.get_num_reserved_bytes() / 1024
+         << " KB" << endl;
 }
 
 std::vector<Loops> TransitionSystem::extract_loops() {
+    assert(store_loops);
     return move(loops);
 }
 
@@ -1,6 +1,8 @@
 #ifndef CEGAR_TRANSITION_SYSTEM_H
 #define CEGAR_TRANSITION_SYSTEM_H
 
+#include "loops.h"
+#include "transition_list.h"
 #include "types.h"
 
 #include <vector>
@@ -13,10 +15,21 @@ class ContextSplitTransitionSystem;
 
 /*
   Rewire transitions after each split.
+
+  If store_loops is false, we don't store self-loops at all. Instead,
+  when splitting a state for a variable, we recompute the self-loops of
+  the state that mention the variable, since only these can turn into
+  state-changing transitions.
 */
 class TransitionSystem {
     const std::vector<std::vector<FactPair>> preconditions_by_operator;
     const std::vector<std::vector<FactPair>> postconditions_by_operator;
+    const bool store_loops;
+    // Operators with a precondition or effect on a variable (only used if !store_loops).
+    const std::vector<std::vector<int>> operators_by_var;
+
+    // Memory for the compressed transition lists below.
+    TransitionListAllocator transition_list_allocator;
 
     // Transitions from and to other abstract states.
     // The target of an incoming edge is the predecessor.
@@ -24,7 +37,7 @@ class TransitionSystem {
     std::vector<Transitions> incoming;
     std::vector<Transitions> outgoing;
 
-    // Store self-loops (operator indices) separately to save space.
+    // Store self-loops (operator indices) separately and compressed to save space.
     std::vector<Loops> loops;
 
     int num_non_loops;
@@ -41,6 +54,11 @@ class TransitionSystem {
     void add_transition(int src_id, int op_id, int target_id);
     void add_loop(int state_id, int op_id);
 
+    bool operator_loops_in_union(
+        int op_id, const AbstractState &v1, const AbstractState &v2, int var) const;
+    Loops compute_loops_mentioning_var(
+        const AbstractState &v1, const AbstractState &v2, int var) const;
+
     void rewire_incoming_transitions(
         const Transitions &old_incoming, const AbstractStates &states,
         const AbstractState &v1, const AbstractState &v2, int var);
@@ -52,7 +70,7 @@ class TransitionSystem {
         const AbstractState &v1, const AbstractState &v2, int var);
 
 public:
-    explicit TransitionSystem(const OperatorsProxy &ops);
+    TransitionSystem(const OperatorsProxy &ops, bool store_loops);
 
     virtual ~TransitionSystem();
 
@@ -63,6 +81,7 @@ public:
 
     const std::vector<Transitions> &get_incoming_transitions() const;
     const std::vector<Transitions> &get_outgoing_transitions() const;
+    // Only available if self-loops are stored.
     const std::vector<Loops> &get_loops() const;
 
     int get_num_states() const;
@@ -72,10 +91,6 @@ public:
 
     void print_statistics() const;
 
-    std::vector<Transitions> extract_outgoing();
-
-    std::vector<Transitions> extract_incoming();
-
     std::vector<Loops> extract_loops();
 };
 }
@@ -8,14 +8,15 @@
 
 namespace cegar {
 class AbstractState;
+class Loops;
 struct Transition;
+class TransitionList;
 
 using AbstractStates = std::vector<std::unique_ptr<AbstractState>>;
 using Goals = std::unordered_set<int>;
 using NodeID = int;
 using Loop = int;
-using Loops = std::vector<Loop>;
-using Transitions = std::vector<Transition>;
+using Transitions = TransitionList;
 
 const int UNDEFINED = -1;
 
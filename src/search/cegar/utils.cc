@@ -19,6 +19,8 @@ unique_ptr<additive_heuristic::AdditiveHeuristic> create_additive_heuristic(
     Options opts;
     opts.set<shared_ptr<AbstractTask>>("transform", task);
     opts.set<bool>("cache_estimates", false);
+    opts.set<int>(
+        "exploration", static_cast<int>(relaxation_heuristic::Exploration::QUEUE));
     return utils::make_unique_ptr<additive_heuristic::AdditiveHeuristic>(opts);
 }
 
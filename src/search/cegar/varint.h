@@ -0,0 +1,50 @@
+#ifndef CEGAR_VARINT_H
+#define CEGAR_VARINT_H
+
+#include <cassert>
+#include <cstdint>
+
+namespace cegar {
+/*
+  Variable-length encoding of non-negative integers with 7 payload bits
+  per byte. The highest bit of a byte is set iff more bytes follow.
+*/
+namespace varint {
+const int MAX_ENCODED_SIZE = 5;
+
+inline int get_encoded_size(int value) {
+    assert(value >= 0);
+    int size = 1;
+    while (value >= 128) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+// Write value to pos and return the position after it.
+inline uint8_t *encode(int value, uint8_t *pos) {
+    assert(value >= 0);
+    while (value >= 128) {
+        *pos++ = static_cast<uint8_t>((value & 127) | 128);
+        value >>= 7;
+    }
+    *pos++ = static_cast<uint8_t>(value);
+    return pos;
+}
+
+// Read the value at pos and advance pos behind it.
+inline int decode(const uint8_t *&pos) {
+    int value = 0;
+    int shift = 0;
+    while (*pos & 128) {
+        value |= (*pos++ & 127) << shift;
+        shift += 7;
+    }
+    value |= *pos++ << shift;
+    return value;
+}
+}
+}
+
+#endif
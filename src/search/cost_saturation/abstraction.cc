@@ -45,6 +45,11 @@ int Abstraction::get_abstract_state_id(const State &concrete_state) const {
     return abstraction_function->get_abstract_state_id(concrete_state);
 }
 
+int Abstraction::get_abstract_state_id(const PackedStateView &concrete_state) const {
+    assert(abstraction_function);
+    return abstraction_function->get_abstract_state_id(concrete_state);
+}
+
 unique_ptr<AbstractionFunction> Abstraction::extract_abstraction_function() {
     return move(abstraction_function);
 }
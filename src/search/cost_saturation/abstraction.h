@@ -9,6 +9,7 @@
 #include <ostream>
 #include <vector>
 
+class PackedStateView;
 class State;
 
 namespace cost_saturation {
@@ -51,6 +52,7 @@ class AbstractionFunction {
 public:
     virtual ~AbstractionFunction() = default;
     virtual int get_abstract_state_id(const State &concrete_state) const = 0;
+    virtual int get_abstract_state_id(const PackedStateView &concrete_state) const = 0;
 };
 
 
@@ -96,6 +98,7 @@ public:
     virtual const std::vector<int> &get_goal_states() const = 0;
 
     int get_abstract_state_id(const State &concrete_state) const;
+    int get_abstract_state_id(const PackedStateView &concrete_state) const;
     std::unique_ptr<AbstractionFunction> extract_abstraction_function();
 
     virtual void dump() const = 0;
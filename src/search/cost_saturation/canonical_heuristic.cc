@@ -76,11 +76,10 @@ CanonicalHeuristic::CanonicalHeuristic(const Options &opts)
 }
 
 int CanonicalHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
-    return compute_heuristic(state);
+    return compute_heuristic(convert_global_state_to_view(global_state));
 }
 
-int CanonicalHeuristic::compute_heuristic(const State &state) {
+int CanonicalHeuristic::compute_heuristic(const PackedStateView &state) {
     vector<int> h_values_for_state;
     h_values_for_state.reserve(abstraction_functions.size());
     for (size_t i = 0; i < abstraction_functions.size(); ++i) {
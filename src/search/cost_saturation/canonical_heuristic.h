@@ -21,7 +21,7 @@ class CanonicalHeuristic : public Heuristic {
     MaxAdditiveSubsets max_additive_subsets;
 
     int compute_max_over_sums(const std::vector<int> &h_values_for_state) const;
-    int compute_heuristic(const State &state);
+    int compute_heuristic(const PackedStateView &state);
 
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
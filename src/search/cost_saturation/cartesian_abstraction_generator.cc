@@ -4,6 +4,7 @@
 #include "types.h"
 
 #include "../option_parser.h"
+#include "../packed_state_view.h"
 #include "../plugin.h"
 
 #include "../cegar/abstraction.h"
@@ -23,16 +24,36 @@ using namespace std;
 namespace cost_saturation {
 class CartesianAbstractionFunction : public AbstractionFunction {
     unique_ptr<cegar::RefinementHierarchy> refinement_hierarchy;
+    // Task of the concrete states.
+    shared_ptr<AbstractTask> task;
+    bool subtask_converts_state_values;
 
 public:
-    explicit CartesianAbstractionFunction(
-        unique_ptr<cegar::RefinementHierarchy> refinement_hierarchy)
-        : refinement_hierarchy(move(refinement_hierarchy)) {
+    CartesianAbstractionFunction(
+        unique_ptr<cegar::RefinementHierarchy> refinement_hierarchy,
+        const shared_ptr<AbstractTask> &task)
+        : refinement_hierarchy(move(refinement_hierarchy)),
+          task(task),
+          subtask_converts_state_values(
+              this->refinement_hierarchy->get_task()->does_convert_state_values(
+                  task.get())) {
     }
 
     virtual int get_abstract_state_id(const State &concrete_state) const override {
         return refinement_hierarchy->get_abstract_state_id(concrete_state);
     }
+
+    virtual int get_abstract_state_id(const PackedStateView &concrete_state) const override {
+        if (subtask_converts_state_values) {
+            vector<int> values(concrete_state.size());
+            for (int var = 0; var < concrete_state.size(); ++var) {
+                values[var] = concrete_state[var];
+            }
+            return refinement_hierarchy->get_abstract_state_id(
+                State(*task, move(values)));
+        }
+        return refinement_hierarchy->get_abstract_state_id(concrete_state);
+    }
 };
 
 
@@ -61,7 +82,8 @@ static vector<bool> get_looping_operators(const cegar::TransitionSystem &ts) {
 
 
 static pair<bool, unique_ptr<Abstraction>> convert_abstraction(
-    cegar::Abstraction &cartesian_abstraction, const vector<int> &operator_costs) {
+    cegar::Abstraction &cartesian_abstraction, const vector<int> &operator_costs,
+    const shared_ptr<AbstractTask> &task) {
     // Compute g and h values.
     const cegar::TransitionSystem &ts =
         cartesian_abstraction.get_transition_system();
@@ -100,7 +122,7 @@ static pair<bool, unique_ptr<Abstraction>> convert_abstraction(
                unsolvable,
                utils::make_unique_ptr<ExplicitAbstraction>(
                    utils::make_unique_ptr<CartesianAbstractionFunction>(
-                       cartesian_abstraction.extract_refinement_hierarchy()),
+                       cartesian_abstraction.extract_refinement_hierarchy(), task),
                    move(backward_graph),
                    move(looping_operators),
                    move(goal_states))
@@ -108,6 +130,7 @@ static pair<bool, unique_ptr<Abstraction>> convert_abstraction(
 }
 
 void CartesianAbstractionGenerator::build_abstractions_for_subtasks(
+    const shared_ptr<AbstractTask> &task,
     const vector<shared_ptr<AbstractTask>> &subtasks,
     function<bool()> total_size_limit_reached,
     Abstractions &abstractions) {
@@ -121,8 +144,10 @@ void CartesianAbstractionGenerator::build_abstractions_for_subtasks(
             subtask,
             max(1, (max_states - num_states) / remaining_subtasks),
             max(1, (max_transitions - num_transitions) / remaining_subtasks),
+            1,
             max_time,
             cegar::PickSplit::MAX_REFINED,
+            true,
             *rng,
             debug);
 
@@ -132,7 +157,8 @@ void CartesianAbstractionGenerator::build_abstractions_for_subtasks(
         num_transitions += cartesian_abstraction->get_transition_system().get_num_non_loops();
 
         vector<int> operator_costs = task_properties::get_operator_costs(TaskProxy(*subtask));
-        auto result = convert_abstraction(*cartesian_abstraction, operator_costs);
+        auto result = convert_abstraction(
+            *cartesian_abstraction, operator_costs, task);
         bool unsolvable = result.first;
         abstractions.push_back(move(result.second));
 
@@ -164,7 +190,7 @@ Abstractions CartesianAbstractionGenerator::generate_abstractions(
     for (const auto &subtask_generator : subtask_generators) {
         cegar::SharedTasks subtasks = subtask_generator->get_subtasks(task);
         build_abstractions_for_subtasks(
-            subtasks, total_size_limit_reached, abstractions);
+            task, subtasks, total_size_limit_reached, abstractions);
         if (total_size_limit_reached()) {
             break;
         }
@@ -31,6 +31,7 @@ class CartesianAbstractionGenerator : public AbstractionGenerator {
     int num_transitions;
 
     void build_abstractions_for_subtasks(
+        const std::shared_ptr<AbstractTask> &task,
         const std::vector<std::shared_ptr<AbstractTask>> &subtasks,
         std::function<bool()> total_size_limit_reached,
         Abstractions &abstractions);
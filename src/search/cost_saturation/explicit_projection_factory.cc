@@ -3,6 +3,8 @@
 #include "explicit_abstraction.h"
 #include "types.h"
 
+#include "../packed_state_view.h"
+
 #include "../pdbs/match_tree.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
@@ -69,6 +71,14 @@ public:
         }
         return index;
     }
+
+    virtual int get_abstract_state_id(const PackedStateView &concrete_state) const {
+        int index = 0;
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            index += hash_multipliers[i] * concrete_state[pattern[i]];
+        }
+        return index;
+    }
 };
 
 
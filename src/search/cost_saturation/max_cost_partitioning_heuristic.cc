@@ -94,11 +94,10 @@ MaxCostPartitioningHeuristic::~MaxCostPartitioningHeuristic() {
 }
 
 int MaxCostPartitioningHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
-    return compute_heuristic(state);
+    return compute_heuristic(convert_global_state_to_view(global_state));
 }
 
-int MaxCostPartitioningHeuristic::compute_heuristic(const State &state) const {
+int MaxCostPartitioningHeuristic::compute_heuristic(const PackedStateView &state) const {
     vector<int> abstract_state_ids = get_abstract_state_ids(
         abstraction_functions, state);
     int max_h = compute_max_h_with_statistics(cp_heuristics, abstract_state_ids, num_best_order);
@@ -29,7 +29,7 @@ class MaxCostPartitioningHeuristic : public Heuristic {
     mutable std::vector<int> num_best_order;
 
     void print_statistics() const;
-    int compute_heuristic(const State &state) const;
+    int compute_heuristic(const PackedStateView &state) const;
 
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
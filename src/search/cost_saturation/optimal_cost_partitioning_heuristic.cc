@@ -61,7 +61,7 @@ void OptimalCostPartitioningHeuristic::release_memory() {
 }
 
 int OptimalCostPartitioningHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State concrete_state = convert_global_state(global_state);
+    PackedStateView concrete_state = convert_global_state_to_view(global_state);
     // Set upper bound for distance of current abstract states to 0 and for all other
     // abstract states to infinity.
     for (int id = 0; id < static_cast<int>(abstraction_functions.size()); ++id) {
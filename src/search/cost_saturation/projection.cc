@@ -3,6 +3,7 @@
 #include "types.h"
 #include "utils.h"
 
+#include "../packed_state_view.h"
 #include "../task_proxy.h"
 
 #include "../algorithms/priority_queues.h"
@@ -169,6 +170,15 @@ int ProjectionFunction::get_abstract_state_id(const State &concrete_state) const
     return index;
 }
 
+int ProjectionFunction::get_abstract_state_id(
+    const PackedStateView &concrete_state) const {
+    size_t index = 0;
+    for (const VariableAndMultiplier &pair : variables_and_multipliers) {
+        index += pair.hash_multiplier * concrete_state[pair.pattern_var];
+    }
+    return index;
+}
+
 
 Projection::Projection(
     const TaskProxy &task_proxy,
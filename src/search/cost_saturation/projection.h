@@ -92,6 +92,7 @@ public:
         const pdbs::Pattern &pattern, const std::vector<std::size_t> &hash_multipliers);
 
     virtual int get_abstract_state_id(const State &concrete_state) const override;
+    virtual int get_abstract_state_id(const PackedStateView &concrete_state) const override;
 };
 
 
@@ -74,7 +74,7 @@ SaturatedCostPartitioningOnlineHeuristic::~SaturatedCostPartitioningOnlineHeuris
 
 int SaturatedCostPartitioningOnlineHeuristic::compute_heuristic(
     const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    PackedStateView state = convert_global_state_to_view(global_state);
     vector<int> abstract_state_ids = get_abstract_state_ids(abstractions, state);
     Order order = cp_generator->compute_order_for_state(
         abstractions, costs, abstract_state_ids, num_scps_computed == 0);
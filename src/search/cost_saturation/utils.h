@@ -40,9 +40,10 @@ extern int compute_max_h_with_statistics(
     const std::vector<int> &abstract_state_ids,
     std::vector<int> &num_best_order);
 
-template<typename AbstractionsOrFunctions>
+// StateType is State or PackedStateView.
+template<typename AbstractionsOrFunctions, typename StateType>
 std::vector<int> get_abstract_state_ids(
-    const AbstractionsOrFunctions &abstractions, const State &state) {
+    const AbstractionsOrFunctions &abstractions, const StateType &state) {
     std::vector<int> abstract_state_ids;
     abstract_state_ids.reserve(abstractions.size());
     for (auto &abstraction : abstractions) {
@@ -35,6 +35,11 @@ State GlobalState::unpack() const {
     return task_proxy.create_state(move(values));
 }
 
+PackedStateView GlobalState::get_packed_view() const {
+    return PackedStateView(
+        buffer, registry->get_state_packer(), registry->get_num_variables());
+}
+
 void GlobalState::dump_pddl() const {
     State state = unpack();
     task_properties::dump_pddl(state);
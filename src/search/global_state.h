@@ -1,15 +1,12 @@
 #ifndef GLOBAL_STATE_H
 #define GLOBAL_STATE_H
 
+#include "packed_state_view.h"
 #include "state_id.h"
 
-#include "algorithms/int_packer.h"
-
 class State;
 class StateRegistry;
 
-using PackedStateBin = int_packer::IntPacker::Bin;
-
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 class GlobalState {
@@ -49,6 +46,12 @@ public:
 
     State unpack() const;
 
+    /*
+      Returns a view that reads the values of this state from the packed
+      data in the registry. Unlike unpack(), this does not copy anything.
+    */
+    PackedStateView get_packed_view() const;
+
     void dump_pddl() const;
     void dump_fdr() const;
 };
@@ -17,10 +17,14 @@ using namespace std;
 
 Heuristic::Heuristic(const Options &opts)
     : Evaluator(opts.get_unparsed_config(), true, true, true),
+      converted_state_packer(nullptr),
       heuristic_cache(HEntry(NO_VALUE, true)), //TODO: is true really a good idea here?
       cache_evaluator_values(opts.get<bool>("cache_estimates")),
       task(opts.get<shared_ptr<AbstractTask>>("transform")),
       task_proxy(*task) {
+    if (task->does_convert_state_values(tasks::g_root_task.get())) {
+        converted_state_packer = &task_properties::g_state_packers[task_proxy];
+    }
 }
 
 Heuristic::~Heuristic() {
@@ -34,6 +38,22 @@ State Heuristic::convert_global_state(const GlobalState &global_state) const {
     return task_proxy.convert_ancestor_state(global_state.unpack());
 }
 
+PackedStateView Heuristic::convert_global_state_to_view(
+    const GlobalState &global_state) {
+    if (!converted_state_packer) {
+        return global_state.get_packed_view();
+    }
+    State state = convert_global_state(global_state);
+    // Avoid garbage values in half-full bins.
+    converted_state_buffer.assign(converted_state_packer->get_num_bins(), 0);
+    for (size_t var = 0; var < state.size(); ++var) {
+        converted_state_packer->set(
+            converted_state_buffer.data(), var, state[var].get_value());
+    }
+    return PackedStateView(
+        converted_state_buffer.data(), *converted_state_packer, state.size());
+}
+
 void Heuristic::add_options_to_parser(OptionParser &parser) {
     parser.add_option<shared_ptr<AbstractTask>>(
         "transform",
@@ -44,6 +44,13 @@ class Heuristic : public Evaluator {
     */
     ordered_set::OrderedSet<OperatorID> preferred_operators;
 
+    /*
+      If the task of the heuristic converts the state values of the root
+      task, we pack converted states into this buffer to view them.
+    */
+    const int_packer::IntPacker *converted_state_packer;
+    std::vector<PackedStateBin> converted_state_buffer;
+
 protected:
     /*
       Cache for saving h values
@@ -75,6 +82,14 @@ protected:
        heuristics use the TaskProxy class. */
     State convert_global_state(const GlobalState &global_state) const;
 
+    /*
+      Cheaper alternative to convert_global_state() for heuristics that only
+      need read access to the state values. Unless the task transformation
+      changes state values, the view reads directly from the state registry.
+      The view is only valid until the next call.
+    */
+    PackedStateView convert_global_state_to_view(const GlobalState &global_state);
+
 public:
     explicit Heuristic(const options::Options &opts);
     virtual ~Heuristic() override;
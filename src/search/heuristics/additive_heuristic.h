@@ -20,15 +20,6 @@ using relaxation_heuristic::Proposition;
 using relaxation_heuristic::UnaryOperator;
 
 class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
-    /* Costs larger than MAX_COST_VALUE are clamped to max_value. The
-       precise value (100M) is a bit of a hack, since other parts of
-       the code don't reliably check against overflow as of this
-       writing. With a value of 100M, we want to ensure that even
-       weighted A* with a weight of 10 will have f values comfortably
-       below the signed 32-bit int upper bound.
-     */
-    static const int MAX_COST_VALUE = 100000000;
-
     priority_queues::AdaptiveQueue<PropID> queue;
     bool did_write_overflow_warning;
 
@@ -4,25 +4,62 @@
 #include "../plugin.h"
 
 #include "../task_utils/task_properties.h"
-#include "../utils/logging.h"
+#include "../utils/collections.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <limits>
-#include <set>
 
 using namespace std;
 
 namespace hm_heuristic {
+static const int INF = numeric_limits<int>::max();
+
 HMHeuristic::HMHeuristic(const Options &opts)
     : Heuristic(opts),
       m(opts.get<int>("m")),
       has_cond_effects(task_properties::has_conditional_effects(task_proxy)),
-      goals(task_properties::get_fact_pairs(task_proxy.get_goals())) {
+      num_facts(0),
+      was_updated(false) {
     cout << "Using h^" << m << "." << endl;
-    cout << "The implementation of the h^m heuristic is preliminary." << endl
-         << "It is SLOOOOOOOOOOOW." << endl
-         << "Please do not use this for comparison!" << endl;
-    generate_all_tuples();
+
+    VariablesProxy variables = task_proxy.get_variables();
+    fact_offsets.reserve(variables.size());
+    for (VariableProxy var : variables) {
+        fact_offsets.push_back(num_facts);
+        int domain_size = var.get_domain_size();
+        fact_vars.insert(fact_vars.end(), domain_size, var.get_id());
+        num_facts += domain_size;
+    }
+
+    binomials.assign(num_facts + 1, vector<size_t>(m + 1, 0));
+    binomials[0][0] = 1;
+    for (int n = 1; n <= num_facts; ++n) {
+        binomials[n][0] = 1;
+        for (int k = 1; k <= m; ++k)
+            binomials[n][k] = binomials[n - 1][k - 1] + binomials[n - 1][k];
+    }
+    tuple_offsets.assign(m + 2, 0);
+    for (int k = 1; k <= m; ++k)
+        tuple_offsets[k + 1] = tuple_offsets[k] + binomials[num_facts][k];
+    cout << "Size of h^" << m << " table: " << tuple_offsets[m + 1] << endl;
+
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        HMOperator hm_op;
+        hm_op.preconditions = get_fact_ids(
+            task_properties::get_fact_pairs(op.get_preconditions()));
+        for (EffectProxy eff : op.get_effects())
+            hm_op.effects.push_back(get_fact_id(eff.get_fact()));
+        utils::sort_unique(hm_op.effects);
+        hm_op.cost = op.get_cost();
+        operators.push_back(move(hm_op));
+    }
+    goals = get_fact_ids(task_properties::get_fact_pairs(task_proxy.get_goals()));
+
+    hm_table.resize(tuple_offsets[m + 1]);
+    precondition_of_var.resize(variables.size(), -1);
+    is_affected_var.resize(variables.size(), false);
 }
 
 
@@ -31,233 +68,233 @@ bool HMHeuristic::dead_ends_are_reliable() const {
 }
 
 
+int HMHeuristic::get_fact_id(const FactProxy &fact) const {
+    return fact_offsets[fact.get_variable().get_id()] + fact.get_value();
+}
+
+
+vector<int> HMHeuristic::get_fact_ids(const vector<FactPair> &facts) const {
+    vector<int> fact_ids;
+    fact_ids.reserve(facts.size());
+    for (const FactPair &fact : facts)
+        fact_ids.push_back(fact_offsets[fact.var] + fact.value);
+    sort(fact_ids.begin(), fact_ids.end());
+    return fact_ids;
+}
+
+
+size_t HMHeuristic::get_tuple_index(const vector<int> &sorted_tuple) const {
+    int size = sorted_tuple.size();
+    assert(size >= 1 && size <= m);
+    size_t index = tuple_offsets[size];
+    for (int i = 0; i < size; ++i) {
+        assert(i == 0 || sorted_tuple[i - 1] < sorted_tuple[i]);
+        index += binomials[sorted_tuple[i]][i + 1];
+    }
+    return index;
+}
+
+
 int HMHeuristic::compute_heuristic(const GlobalState &global_state) {
     State state = convert_global_state(global_state);
     if (task_properties::is_goal_state(task_proxy, state)) {
         return 0;
     } else {
-        Tuple s_tup = task_properties::get_fact_pairs(state);
-
-        init_hm_table(s_tup);
+        init_hm_table(state);
         update_hm_table();
 
         int h = eval(goals);
 
-        if (h == numeric_limits<int>::max())
+        if (h == INF)
             return DEAD_END;
         return h;
     }
 }
 
 
-void HMHeuristic::init_hm_table(const Tuple &t) {
-    for (auto &hm_ent : hm_table) {
-        const Tuple &tuple = hm_ent.first;
-        int h_val = check_tuple_in_tuple(tuple, t);
-        hm_table[tuple] = h_val;
+void HMHeuristic::init_hm_table(const State &state) {
+    fill(hm_table.begin(), hm_table.end(), INF);
+    vector<int> state_facts;
+    state_facts.reserve(state.size());
+    for (FactProxy fact : state)
+        state_facts.push_back(get_fact_id(fact));
+    set_subtuples_to_zero(state_facts, 0, 0, 0);
+}
+
+
+void HMHeuristic::set_subtuples_to_zero(
+    const vector<int> &facts, int start, int size, size_t rank) {
+    int num_facts_in_set = facts.size();
+    for (int i = start; i < num_facts_in_set; ++i) {
+        size_t new_rank = rank + binomials[facts[i]][size + 1];
+        hm_table[tuple_offsets[size + 1] + new_rank] = 0;
+        if (size + 1 < m)
+            set_subtuples_to_zero(facts, i + 1, size + 1, new_rank);
     }
 }
 
 
 void HMHeuristic::update_hm_table() {
-    int round = 0;
+    /*
+      The update order does not affect the fixpoint. We sweep over all
+      operators until nothing changes, and entries lowered in a sweep are
+      already used by the following operators of the same sweep.
+    */
     do {
-        ++round;
         was_updated = false;
-
-        for (OperatorProxy op : task_proxy.get_operators()) {
-            Tuple pre = get_operator_pre(op);
-
-            int c1 = eval(pre);
-            if (c1 != numeric_limits<int>::max()) {
-                Tuple eff = get_operator_eff(op);
-                vector<Tuple> partial_effs;
-                generate_all_partial_tuples(eff, partial_effs);
-                for (Tuple &partial_eff : partial_effs) {
-                    update_hm_entry(partial_eff, c1 + op.get_cost());
-
-                    int eff_size = partial_eff.size();
-                    if (eff_size < m) {
-                        extend_tuple(partial_eff, op);
-                    }
-                }
-            }
-        }
+        for (const HMOperator &op : operators)
+            apply_operator(op);
     } while (was_updated);
 }
 
 
-void HMHeuristic::extend_tuple(const Tuple &t, const OperatorProxy &op) {
-    for (auto &hm_ent : hm_table) {
-        const Tuple &tuple = hm_ent.first;
-        bool contradict = false;
-        for (const FactPair &fact : tuple) {
-            if (contradict_effect_of(op, fact.var, fact.value)) {
-                contradict = true;
-                break;
-            }
+void HMHeuristic::apply_operator(const HMOperator &op) {
+    int pre_cost = eval(op.preconditions);
+    if (pre_cost == INF)
+        return;
+    update_effect_subtuples(op.effects, 0, 0, 0, -1, pre_cost + op.cost);
+    if (m == 1)
+        return;
+
+    /*
+      A tuple T consisting of effect facts E and other facts O can also be
+      reached with the operator if no fact in O contradicts an effect or a
+      precondition. Its cost is then at most the cost of pre(op) + O plus
+      the operator cost. We only need to consider facts O on variables
+      without effects: for a fact on such a variable, E + O is a cheaper
+      tuple to consider. The candidates for O are stored in
+      extension_candidates and O itself in extension.
+    */
+    for (int fact : op.preconditions)
+        precondition_of_var[fact_vars[fact]] = fact;
+    for (int fact : op.effects)
+        is_affected_var[fact_vars[fact]] = true;
+    extension_candidates.clear();
+    for (int fact = 0; fact < num_facts; ++fact) {
+        int var = fact_vars[fact];
+        if (!is_affected_var[var] &&
+            (precondition_of_var[var] == -1 || precondition_of_var[var] == fact)) {
+            extension_candidates.push_back(fact);
         }
-        if (!contradict && (tuple.size() > t.size()) && (check_tuple_in_tuple(t, tuple) == 0)) {
-            Tuple pre = get_operator_pre(op);
-
-            Tuple others;
-            for (const FactPair &fact : tuple) {
-                if (find(t.begin(), t.end(), fact) == t.end()) {
-                    others.push_back(fact);
-                    if (find(pre.begin(), pre.end(), fact) == pre.end()) {
-                        pre.push_back(fact);
-                    }
-                }
-            }
-
-            sort(pre.begin(), pre.end());
-
-            set<int> vars;
-            bool is_valid = true;
-            for (const FactPair &fact : pre) {
-                if (vars.count(fact.var) != 0) {
-                    is_valid = false;
-                    break;
-                }
-                vars.insert(fact.var);
-            }
-
-            if (is_valid) {
-                int c2 = eval(pre);
-                if (c2 != numeric_limits<int>::max()) {
-                    update_hm_entry(tuple, c2 + op.get_cost());
-                }
-            }
-        }
-    }
-}
-
-
-int HMHeuristic::eval(const Tuple &t) const {
-    vector<Tuple> partial;
-    generate_all_partial_tuples(t, partial);
-    int max = 0;
-    for (Tuple &tuple : partial) {
-        assert(hm_table.count(tuple) == 1);
-
-        int h = hm_table.at(tuple);
-        if (h > max) {
-            max = h;
-        }
-    }
-    return max;
-}
-
-
-int HMHeuristic::update_hm_entry(const Tuple &t, int val) {
-    assert(hm_table.count(t) == 1);
-    if (hm_table[t] > val) {
-        hm_table[t] = val;
-        was_updated = true;
     }
-    return val;
+    assert(extension.empty());
+    extend_operator(op, pre_cost, 0);
+    for (int fact : op.preconditions)
+        precondition_of_var[fact_vars[fact]] = -1;
+    for (int fact : op.effects)
+        is_affected_var[fact_vars[fact]] = false;
 }
 
 
-int HMHeuristic::check_tuple_in_tuple(
-    const Tuple &tuple, const Tuple &big_tuple) const {
-    for (const FactPair &fact0 : tuple) {
-        bool found = false;
-        for (auto &fact1 : big_tuple) {
-            if (fact0 == fact1) {
-                found = true;
-                break;
-            }
+void HMHeuristic::extend_operator(
+    const HMOperator &op, int pre_cost, int start) {
+    int num_candidates = extension_candidates.size();
+    for (int i = start; i < num_candidates; ++i) {
+        int fact = extension_candidates[i];
+        if (!extension.empty() &&
+            fact_vars[fact] == fact_vars[extension.back()]) {
+            continue;
         }
-        if (!found) {
-            return numeric_limits<int>::max();
+        extension.push_back(fact);
+        int cost = eval_extended_preconditions(op, pre_cost);
+        // Larger extensions can only be more expensive.
+        if (cost != INF) {
+            update_extended_effect_subtuples(op.effects, 0, cost + op.cost);
+            if (static_cast<int>(extension.size()) + 1 < m)
+                extend_operator(op, pre_cost, i + 1);
         }
+        extension.pop_back();
     }
-    return 0;
 }
 
 
-HMHeuristic::Tuple HMHeuristic::get_operator_pre(const OperatorProxy &op) const {
-    Tuple preconditions = task_properties::get_fact_pairs(op.get_preconditions());
-    sort(preconditions.begin(), preconditions.end());
-    return preconditions;
+int HMHeuristic::eval_extended_preconditions(
+    const HMOperator &op, int pre_cost) {
+    extended_preconditions.clear();
+    set_union(op.preconditions.begin(), op.preconditions.end(),
+              extension.begin(), extension.end(),
+              back_inserter(extended_preconditions));
+    // Tuples of preconditions only are covered by pre_cost.
+    return eval_subtuples(
+        extended_preconditions, 0, 0, 0, false, true, pre_cost);
 }
 
 
-HMHeuristic::Tuple HMHeuristic::get_operator_eff(const OperatorProxy &op) const {
-    Tuple effects;
-    for (EffectProxy eff : op.get_effects()) {
-        effects.push_back(eff.get_fact().get_pair());
-    }
-    sort(effects.begin(), effects.end());
-    return effects;
-}
-
-
-bool HMHeuristic::contradict_effect_of(
-    const OperatorProxy &op, int var, int val) const {
-    for (EffectProxy eff : op.get_effects()) {
-        FactProxy fact = eff.get_fact();
-        if (fact.get_variable().get_id() == var && fact.get_value() != val) {
-            return true;
+void HMHeuristic::update_effect_subtuples(
+    const vector<int> &effects, int start, int size, size_t rank,
+    int last_var, int val) {
+    int num_effects = effects.size();
+    for (int i = start; i < num_effects; ++i) {
+        int fact = effects[i];
+        // Conditional effects may have several facts of the same variable.
+        if (fact_vars[fact] == last_var)
+            continue;
+        size_t new_rank = rank + binomials[fact][size + 1];
+        update_hm_entry(tuple_offsets[size + 1] + new_rank, val);
+        if (size + 1 < m) {
+            update_effect_subtuples(
+                effects, i + 1, size + 1, new_rank, fact_vars[fact], val);
         }
     }
-    return false;
-}
-
-
-void HMHeuristic::generate_all_tuples() {
-    Tuple t;
-    generate_all_tuples_aux(0, m, t);
 }
 
 
-void HMHeuristic::generate_all_tuples_aux(int var, int sz, const Tuple &base) {
-    int num_variables = task_proxy.get_variables().size();
-    for (int i = var; i < num_variables; ++i) {
-        int domain_size = task_proxy.get_variables()[i].get_domain_size();
-        for (int j = 0; j < domain_size; ++j) {
-            Tuple tuple(base);
-            tuple.emplace_back(i, j);
-            hm_table[tuple] = 0;
-            if (sz > 1) {
-                generate_all_tuples_aux(i + 1, sz - 1, tuple);
-            }
+void HMHeuristic::update_extended_effect_subtuples(
+    const vector<int> &effects, int start, int val) {
+    int num_effects = effects.size();
+    for (int i = start; i < num_effects; ++i) {
+        int fact = effects[i];
+        if (!effect_tuple.empty() &&
+            fact_vars[fact] == fact_vars[effect_tuple.back()]) {
+            continue;
         }
+        effect_tuple.push_back(fact);
+        merged_tuple.clear();
+        merge(effect_tuple.begin(), effect_tuple.end(),
+              extension.begin(), extension.end(),
+              back_inserter(merged_tuple));
+        update_hm_entry(get_tuple_index(merged_tuple), val);
+        if (static_cast<int>(merged_tuple.size()) < m)
+            update_extended_effect_subtuples(effects, i + 1, val);
+        effect_tuple.pop_back();
     }
 }
 
 
-void HMHeuristic::generate_all_partial_tuples(
-    const Tuple &base_tuple, vector<Tuple> &res) const {
-    Tuple t;
-    generate_all_partial_tuples_aux(base_tuple, t, 0, m, res);
+int HMHeuristic::eval(const vector<int> &facts) const {
+    return eval_subtuples(facts, 0, 0, 0, false, false, 0);
 }
 
 
-void HMHeuristic::generate_all_partial_tuples_aux(
-    const Tuple &base_tuple, const Tuple &t, int index, int sz, vector<Tuple> &res) const {
-    if (sz == 1) {
-        for (size_t i = index; i < base_tuple.size(); ++i) {
-            Tuple tuple(t);
-            tuple.push_back(base_tuple[i]);
-            res.push_back(tuple);
+int HMHeuristic::eval_subtuples(
+    const vector<int> &facts, int start, int size, size_t rank,
+    bool has_new_fact, bool only_new_facts, int max_value) const {
+    /*
+      Return the maximum of max_value and the h^m values of all tuples of
+      at most m facts from the given sorted facts (extending the tuple of
+      the given size and rank). If only_new_facts is true, only consider
+      tuples containing a fact that is not a precondition.
+    */
+    int num_facts_in_set = facts.size();
+    for (int i = start; i < num_facts_in_set; ++i) {
+        int fact = facts[i];
+        bool has_new = has_new_fact || (only_new_facts && !is_precondition(fact));
+        size_t new_rank = rank + binomials[fact][size + 1];
+        if (has_new || !only_new_facts) {
+            max_value = max(
+                max_value, hm_table[tuple_offsets[size + 1] + new_rank]);
+            if (max_value == INF)
+                return INF;
         }
-    } else {
-        for (size_t i = index; i < base_tuple.size(); ++i) {
-            Tuple tuple(t);
-            tuple.push_back(base_tuple[i]);
-            res.push_back(tuple);
-            generate_all_partial_tuples_aux(base_tuple, tuple, i + 1, sz - 1, res);
+        if (size + 1 < m) {
+            max_value = eval_subtuples(
+                facts, i + 1, size + 1, new_rank, has_new, only_new_facts,
+                max_value);
+            if (max_value == INF)
+                return INF;
         }
     }
-}
-
-
-void HMHeuristic::dump_table() const {
-    for (auto &hm_ent : hm_table) {
-        cout << "h(" << hm_ent.first << ") = " << hm_ent.second << endl;
-    }
+    return max_value;
 }
 
 
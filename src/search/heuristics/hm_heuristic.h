@@ -3,10 +3,7 @@
 
 #include "../heuristic.h"
 
-#include <algorithm>
-#include <iostream>
-#include <map>
-#include <string>
+#include <cstddef>
 #include <vector>
 
 namespace options {
@@ -17,45 +14,87 @@ namespace hm_heuristic {
 /*
   Haslum's h^m heuristic family ("critical path heuristics").
 
-  This is a very slow implementation and should not be used for
-  speed benchmarks.
-*/
+  Facts are numbered consecutively and a tuple is a set of at most m facts
+  of pairwise different variables, represented as a sorted vector of fact
+  IDs. The h^m table is a flat array indexed by the position of the tuple
+  in the combinatorial number system: the tuple {f_0 < ... < f_{k-1}} has
+  index tuple_offsets[k] + sum_i binomial(f_i, i + 1). Index ranges of
+  tuples with two facts of the same variable are allocated but unused.
 
+  The table needs sum_{k=1}^{m} binomial(#facts, k) entries, so m > 2 is
+  only feasible for small tasks.
+*/
 class HMHeuristic : public Heuristic {
-    using Tuple = std::vector<FactPair>;
+    struct HMOperator {
+        std::vector<int> preconditions;
+        std::vector<int> effects;
+        int cost;
+    };
+
     // parameters
     const int m;
     const bool has_cond_effects;
 
-    const Tuple goals;
+    int num_facts;
+    // fact_offsets[var]: ID of the fact var=0
+    std::vector<int> fact_offsets;
+    std::vector<int> fact_vars;
+    // binomials[n][k] = n choose k for 0 <= n <= num_facts, 0 <= k <= m
+    std::vector<std::vector<std::size_t>> binomials;
+    // tuple_offsets[k]: index of the first tuple with k facts
+    std::vector<std::size_t> tuple_offsets;
+
+    std::vector<HMOperator> operators;
+    std::vector<int> goals;
 
     // h^m table
-    std::map<Tuple, int> hm_table;
+    std::vector<int> hm_table;
     bool was_updated;
 
+    /*
+      Scratch space for applying operators. precondition_of_var[var] is
+      the precondition fact on var (or -1) and is_affected_var[var] tells
+      whether the operator has an effect on var. See apply_operator() for
+      the other vectors.
+    */
+    std::vector<int> precondition_of_var;
+    std::vector<bool> is_affected_var;
+    std::vector<int> extension_candidates;
+    std::vector<int> extension;
+    std::vector<int> extended_preconditions;
+    std::vector<int> effect_tuple;
+    std::vector<int> merged_tuple;
+
+    int get_fact_id(const FactProxy &fact) const;
+    std::vector<int> get_fact_ids(const std::vector<FactPair> &facts) const;
+    std::size_t get_tuple_index(const std::vector<int> &sorted_tuple) const;
+
     // auxiliary methods
-    void init_hm_table(const Tuple &t);
+    void init_hm_table(const State &state);
+    void set_subtuples_to_zero(
+        const std::vector<int> &facts, int start, int size, std::size_t rank);
     void update_hm_table();
-    int eval(const Tuple &t) const;
-    int update_hm_entry(const Tuple &t, int val);
-    void extend_tuple(const Tuple &t, const OperatorProxy &op);
-
-    int check_tuple_in_tuple(const Tuple &tuple, const Tuple &big_tuple) const;
-
-    int get_operator_pre_value(const OperatorProxy &op, int var) const;
-    Tuple get_operator_pre(const OperatorProxy &op) const;
-    Tuple get_operator_eff(const OperatorProxy &op) const;
-    bool contradict_effect_of(const OperatorProxy &op, int var, int val) const;
-
-    void generate_all_tuples();
-    void generate_all_tuples_aux(int var, int sz, const Tuple &base);
-
-    void generate_all_partial_tuples(const Tuple &base_tuple,
-                                     std::vector<Tuple> &res) const;
-    void generate_all_partial_tuples_aux(const Tuple &base_tuple, const Tuple &t, int index,
-                                         int sz, std::vector<Tuple> &res) const;
-
-    void dump_table() const;
+    void apply_operator(const HMOperator &op);
+    void extend_operator(const HMOperator &op, int pre_cost, int start);
+    int eval_extended_preconditions(const HMOperator &op, int pre_cost);
+    void update_effect_subtuples(
+        const std::vector<int> &effects, int start, int size,
+        std::size_t rank, int last_var, int val);
+    void update_extended_effect_subtuples(
+        const std::vector<int> &effects, int start, int val);
+    int eval(const std::vector<int> &facts) const;
+    int eval_subtuples(
+        const std::vector<int> &facts, int start, int size, std::size_t rank,
+        bool has_new_fact, bool only_new_facts, int max_value) const;
+    bool is_precondition(int fact) const {
+        return precondition_of_var[fact_vars[fact]] == fact;
+    }
+    void update_hm_entry(std::size_t index, int val) {
+        if (hm_table[index] > val) {
+            hm_table[index] = val;
+            was_updated = true;
+        }
+    }
 
 protected:
     virtual int compute_heuristic(const GlobalState &global_state);
@@ -12,7 +12,10 @@
 
 namespace lm_cut_heuristic {
 // TODO: Fix duplication with the other relaxation heuristics.
-struct RelaxedProposition;
+using PropID = int;
+using OpID = int;
+
+const PropID NO_PROP = -1;
 
 enum PropositionStatus {
     UNREACHED = 0,
@@ -21,64 +24,115 @@ enum PropositionStatus {
     BEFORE_GOAL_ZONE = 3
 };
 
+/*
+  Compact representation of a list of int lists (e.g., the preconditions of
+  all operators) in one contiguous array. Lists can only be appended.
+*/
+class FlatIndexLists {
+    std::vector<int> offsets;
+    std::vector<int> entries;
+public:
+    class Range {
+        const int *first;
+        const int *last;
+    public:
+        Range(const int *first, const int *last)
+            : first(first),
+              last(last) {
+        }
+
+        const int *begin() const {
+            return first;
+        }
+
+        const int *end() const {
+            return last;
+        }
+
+        int size() const {
+            return last - first;
+        }
+    };
+
+    FlatIndexLists()
+        : offsets(1, 0) {
+    }
+
+    void push_back(const std::vector<int> &list) {
+        entries.insert(entries.end(), list.begin(), list.end());
+        offsets.push_back(entries.size());
+    }
+
+    Range operator[](int index) const {
+        assert(index >= 0 && index + 1 < static_cast<int>(offsets.size()));
+        const int *data = entries.data();
+        return Range(data + offsets[index], data + offsets[index + 1]);
+    }
+};
+
 struct RelaxedOperator {
     int original_op_id;
-    std::vector<RelaxedProposition *> preconditions;
-    std::vector<RelaxedProposition *> effects;
     int base_cost; // 0 for axioms, 1 for regular operators
 
     int cost;
     int unsatisfied_preconditions;
     int h_max_supporter_cost; // h_max_cost of h_max_supporter
-    RelaxedProposition *h_max_supporter;
-    RelaxedOperator(std::vector<RelaxedProposition *> &&pre,
-                    std::vector<RelaxedProposition *> &&eff,
-                    int op_id, int base)
-        : original_op_id(op_id), preconditions(pre), effects(eff), base_cost(base) {
-    }
+    PropID h_max_supporter;
 
-    inline void update_h_max_supporter();
+    RelaxedOperator(int op_id, int base)
+        : original_op_id(op_id), base_cost(base) {
+    }
 };
 
 struct RelaxedProposition {
-    std::vector<RelaxedOperator *> precondition_of;
-    std::vector<RelaxedOperator *> effect_of;
-
     PropositionStatus status;
     int h_max_cost;
 };
 
 class LandmarkCutLandmarks {
+    /*
+      Propositions and operators are identified by their index. The
+      relations between them are stored in flat lists indexed by OpID and
+      PropID, respectively.
+    */
     std::vector<RelaxedOperator> relaxed_operators;
-    std::vector<std::vector<RelaxedProposition>> propositions;
-    RelaxedProposition artificial_precondition;
-    RelaxedProposition artificial_goal;
+    std::vector<RelaxedProposition> propositions;
+    FlatIndexLists operator_preconditions;
+    FlatIndexLists operator_effects;
+    FlatIndexLists precondition_of;
+    FlatIndexLists effect_of;
+    // proposition_offsets[var]: PropID of the first fact of variable var
+    std::vector<PropID> proposition_offsets;
+    PropID artificial_precondition;
+    PropID artificial_goal;
     int num_propositions;
-    priority_queues::AdaptiveQueue<RelaxedProposition *> priority_queue;
+    priority_queues::AdaptiveQueue<PropID> priority_queue;
 
-    void build_relaxed_operator(const OperatorProxy &op);
-    void add_relaxed_operator(std::vector<RelaxedProposition *> &&precondition,
-                              std::vector<RelaxedProposition *> &&effects,
-                              int op_id, int base_cost);
-    RelaxedProposition *get_proposition(const FactProxy &fact);
+    void build_relaxed_operator(
+        const OperatorProxy &op,
+        std::vector<std::vector<PropID>> &preconditions,
+        std::vector<std::vector<PropID>> &effects);
+    PropID get_prop_id(const FactProxy &fact) const;
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
     void first_exploration(const State &state);
-    void first_exploration_incremental(std::vector<RelaxedOperator *> &cut);
+    void first_exploration_incremental(std::vector<OpID> &cut);
     void second_exploration(const State &state,
-                            std::vector<RelaxedProposition *> &second_exploration_queue,
-                            std::vector<RelaxedOperator *> &cut);
+                            std::vector<PropID> &second_exploration_queue,
+                            std::vector<OpID> &cut);
 
-    void enqueue_if_necessary(RelaxedProposition *prop, int cost) {
+    void enqueue_if_necessary(PropID prop_id, int cost) {
         assert(cost >= 0);
-        if (prop->status == UNREACHED || prop->h_max_cost > cost) {
-            prop->status = REACHED;
-            prop->h_max_cost = cost;
-            priority_queue.push(cost, prop);
+        RelaxedProposition &prop = propositions[prop_id];
+        if (prop.status == UNREACHED || prop.h_max_cost > cost) {
+            prop.status = REACHED;
+            prop.h_max_cost = cost;
+            priority_queue.push(cost, prop_id);
         }
     }
 
-    void mark_goal_plateau(RelaxedProposition *subgoal);
+    inline void update_h_max_supporter(RelaxedOperator &op, OpID op_id);
+    void mark_goal_plateau(PropID subgoal);
     void validate_h_max() const;
 public:
     using Landmark = std::vector<int>;
@@ -105,12 +159,14 @@ public:
                            LandmarkCallback landmark_callback);
 };
 
-inline void RelaxedOperator::update_h_max_supporter() {
-    assert(!unsatisfied_preconditions);
-    for (size_t i = 0; i < preconditions.size(); ++i)
-        if (preconditions[i]->h_max_cost > h_max_supporter->h_max_cost)
-            h_max_supporter = preconditions[i];
-    h_max_supporter_cost = h_max_supporter->h_max_cost;
+inline void LandmarkCutLandmarks::update_h_max_supporter(
+    RelaxedOperator &op, OpID op_id) {
+    assert(!op.unsatisfied_preconditions);
+    for (PropID pre : operator_preconditions[op_id])
+        if (propositions[pre].h_max_cost >
+            propositions[op.h_max_supporter].h_max_cost)
+            op.h_max_supporter = pre;
+    op.h_max_supporter_cost = propositions[op.h_max_supporter].h_max_cost;
 }
 }
 
@@ -1,5 +1,7 @@
 #include "relaxation_heuristic.h"
 
+#include "../option_parser.h"
+
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
 #include "../utils/timer.h"
@@ -7,12 +9,17 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
 #include <unordered_map>
 #include <vector>
 
 using namespace std;
 
 namespace relaxation_heuristic {
+static const int INFINITE_COST = numeric_limits<int>::max();
+
 Proposition::Proposition()
     : cost(-1),
       reached_by(NO_OP),
@@ -35,7 +42,8 @@ UnaryOperator::UnaryOperator(
 
 // construction and destruction
 RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
-    : Heuristic(opts) {
+    : Heuristic(opts),
+      exploration(Exploration(opts.get_enum("exploration"))) {
     // Build propositions.
     propositions.resize(task_properties::get_num_facts(task_proxy));
 
@@ -87,12 +95,345 @@ RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
             precondition_of_pool.append(precondition_of_vec);
         propositions[prop_id].num_precondition_occurences = precondition_of_vec.size();
     }
+
+    if (exploration == Exploration::INCREMENTAL) {
+        achievers.resize(propositions.size());
+        for (OpID op_id = 0; op_id < num_unary_ops; ++op_id) {
+            achievers[unary_operators[op_id].effect].push_back(op_id);
+        }
+        is_affected.resize(propositions.size(), false);
+    } else if (exploration == Exploration::LAYERED) {
+        build_layered_operators();
+    }
+}
+
+void RelaxationHeuristic::add_options_to_parser(options::OptionParser &parser) {
+    vector<string> explorations;
+    vector<string> exploration_docs;
+    explorations.push_back("QUEUE");
+    exploration_docs.push_back(
+        "explore from scratch with a priority queue and stop once all "
+        "goals are reached");
+    explorations.push_back("INCREMENTAL");
+    exploration_docs.push_back(
+        "repair the proposition costs of the previously evaluated state. "
+        "This pays off if consecutively evaluated states differ in few "
+        "facts, e.g., for the successors of a state in eager search");
+    explorations.push_back("LAYERED");
+    exploration_docs.push_back(
+        "sweep over all operators in a fixed order until no cost changes. "
+        "This pays off for operators with many preconditions");
+    parser.add_enum_option(
+        "exploration",
+        explorations,
+        "how to compute the costs of the propositions. INCREMENTAL and "
+        "LAYERED explore to the fixpoint instead of stopping once all goals "
+        "are reached. They yield the same h^add and h^max values as QUEUE, "
+        "but relaxed plans and preferred operators may differ since ties "
+        "between achievers are broken differently.",
+        "QUEUE",
+        exploration_docs);
+    Heuristic::add_options_to_parser(parser);
 }
 
 bool RelaxationHeuristic::dead_ends_are_reliable() const {
     return !task_properties::has_axioms(task_proxy);
 }
 
+void RelaxationHeuristic::mark_affected(PropID prop_id) {
+    if (!is_affected[prop_id]) {
+        is_affected[prop_id] = true;
+        affected_propositions.push_back(prop_id);
+    }
+}
+
+void RelaxationHeuristic::relax_operator(OpID op_id, bool use_max) {
+    int cost = 0;
+    for (PropID precond : get_preconditions(op_id)) {
+        int precond_cost = propositions[precond].cost;
+        if (precond_cost == -1)
+            return;
+        if (use_max) {
+            cost = max(cost, precond_cost);
+        } else {
+            cost += precond_cost;
+            if (cost > MAX_COST_VALUE)
+                cost = MAX_COST_VALUE;
+        }
+    }
+    const UnaryOperator &op = unary_operators[op_id];
+    cost += op.base_cost;
+    if (!use_max && cost > MAX_COST_VALUE)
+        cost = MAX_COST_VALUE;
+    Proposition &effect = propositions[op.effect];
+    if (effect.cost == -1 || cost < effect.cost) {
+        effect.cost = cost;
+        effect.reached_by = op_id;
+        incremental_queue.push(cost, op.effect);
+    }
+}
+
+void RelaxationHeuristic::propagate_cost_decreases(bool use_max) {
+    while (!incremental_queue.empty()) {
+        pair<int, PropID> top_pair = incremental_queue.pop();
+        int distance = top_pair.first;
+        PropID prop_id = top_pair.second;
+        const Proposition &prop = propositions[prop_id];
+        assert(prop.cost >= 0 && prop.cost <= distance);
+        if (prop.cost < distance)
+            continue;
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop.precondition_of, prop.num_precondition_occurences)) {
+            relax_operator(op_id, use_max);
+        }
+    }
+}
+
+void RelaxationHeuristic::recompute_costs_from_scratch(
+    const State &state, bool use_max) {
+    // Like the exploration of the subclasses, but without stopping early.
+    incremental_queue.clear();
+    for (Proposition &prop : propositions) {
+        prop.cost = -1;
+        prop.reached_by = NO_OP;
+    }
+    for (FactProxy fact : state) {
+        PropID prop_id = get_prop_id(fact);
+        propositions[prop_id].cost = 0;
+        incremental_queue.push(0, prop_id);
+    }
+    int num_unary_ops = unary_operators.size();
+    for (OpID op_id = 0; op_id < num_unary_ops; ++op_id) {
+        UnaryOperator &op = unary_operators[op_id];
+        op.unsatisfied_preconditions = op.num_preconditions;
+        op.cost = op.base_cost;
+        if (op.unsatisfied_preconditions == 0)
+            relax_operator(op_id, use_max);
+    }
+    while (!incremental_queue.empty()) {
+        pair<int, PropID> top_pair = incremental_queue.pop();
+        int distance = top_pair.first;
+        PropID prop_id = top_pair.second;
+        const Proposition &prop = propositions[prop_id];
+        assert(prop.cost >= 0 && prop.cost <= distance);
+        if (prop.cost < distance)
+            continue;
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop.precondition_of, prop.num_precondition_occurences)) {
+            UnaryOperator &op = unary_operators[op_id];
+            if (use_max) {
+                op.cost = max(op.cost, op.base_cost + prop.cost);
+            } else {
+                op.cost += prop.cost;
+                if (op.cost > MAX_COST_VALUE)
+                    op.cost = MAX_COST_VALUE;
+            }
+            --op.unsatisfied_preconditions;
+            assert(op.unsatisfied_preconditions >= 0);
+            if (op.unsatisfied_preconditions == 0) {
+                Proposition &effect = propositions[op.effect];
+                if (effect.cost == -1 || op.cost < effect.cost) {
+                    effect.cost = op.cost;
+                    effect.reached_by = op_id;
+                    incremental_queue.push(op.cost, op.effect);
+                }
+            }
+        }
+    }
+    explored_state_values = state.get_values();
+}
+
+void RelaxationHeuristic::clear_affected_propositions() {
+    for (PropID prop_id : affected_propositions)
+        is_affected[prop_id] = false;
+    affected_propositions.clear();
+}
+
+void RelaxationHeuristic::compute_costs_incrementally(
+    const State &state, bool use_max) {
+    const vector<int> &values = state.get_values();
+    if (explored_state_values.empty()) {
+        recompute_costs_from_scratch(state, use_max);
+        return;
+    }
+
+    // Repairing many changes or a large cone is slower than starting over.
+    int num_vars = values.size();
+    int max_changes = max(1, num_vars / 4);
+    assert(affected_propositions.empty() && added_propositions.empty());
+    for (int var = 0; var < num_vars; ++var) {
+        int old_value = explored_state_values[var];
+        if (values[var] != old_value) {
+            mark_affected(get_prop_id(var, old_value));
+            added_propositions.push_back(get_prop_id(var, values[var]));
+        }
+    }
+    if (static_cast<int>(added_propositions.size()) > max_changes) {
+        clear_affected_propositions();
+        added_propositions.clear();
+        recompute_costs_from_scratch(state, use_max);
+        return;
+    }
+
+    /*
+      Collect the cone of propositions whose cheapest achiever depends on
+      a removed fact. The list grows while we iterate over it.
+    */
+    for (size_t i = 0; i < affected_propositions.size(); ++i) {
+        const Proposition &prop = propositions[affected_propositions[i]];
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop.precondition_of, prop.num_precondition_occurences)) {
+            PropID effect = unary_operators[op_id].effect;
+            if (propositions[effect].reached_by == op_id)
+                mark_affected(effect);
+        }
+    }
+    if (affected_propositions.size() > propositions.size() / 2) {
+        clear_affected_propositions();
+        added_propositions.clear();
+        recompute_costs_from_scratch(state, use_max);
+        return;
+    }
+    for (PropID prop_id : affected_propositions) {
+        propositions[prop_id].cost = -1;
+        propositions[prop_id].reached_by = NO_OP;
+    }
+
+    incremental_queue.clear();
+    for (PropID prop_id : added_propositions) {
+        propositions[prop_id].cost = 0;
+        propositions[prop_id].reached_by = NO_OP;
+        incremental_queue.push(0, prop_id);
+    }
+    added_propositions.clear();
+
+    // Reseed the affected propositions from their unaffected achievers.
+    for (PropID prop_id : affected_propositions) {
+        if (propositions[prop_id].cost == -1) {
+            for (OpID op_id : achievers[prop_id])
+                relax_operator(op_id, use_max);
+        }
+    }
+    clear_affected_propositions();
+
+    propagate_cost_decreases(use_max);
+    explored_state_values = values;
+}
+
+void RelaxationHeuristic::build_layered_operators() {
+    /*
+      Compute the unit-cost layer in which each proposition is reached
+      from the initial state, and order the operators by the layer of
+      their last precondition. Unreachable operators come last.
+    */
+    int num_propositions = propositions.size();
+    int num_unary_ops = unary_operators.size();
+    vector<int> prop_layers(num_propositions, INFINITE_COST);
+    for (FactProxy fact : task_proxy.get_initial_state())
+        prop_layers[get_prop_id(fact)] = 0;
+    vector<int> op_layers(num_unary_ops, INFINITE_COST);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (OpID op_id = 0; op_id < num_unary_ops; ++op_id) {
+            int layer = 0;
+            for (PropID precond : get_preconditions(op_id))
+                layer = max(layer, prop_layers[precond]);
+            if (layer < op_layers[op_id]) {
+                op_layers[op_id] = layer;
+                int &effect_layer = prop_layers[unary_operators[op_id].effect];
+                effect_layer = min(effect_layer, layer + 1);
+                changed = true;
+            }
+        }
+    }
+
+    layered_op_ids.resize(num_unary_ops);
+    iota(layered_op_ids.begin(), layered_op_ids.end(), 0);
+    stable_sort(layered_op_ids.begin(), layered_op_ids.end(),
+                [&] (OpID op1, OpID op2) {
+                    return op_layers[op1] < op_layers[op2];
+                });
+
+    layered_effects.reserve(num_unary_ops);
+    layered_base_costs.reserve(num_unary_ops);
+    layered_precondition_offsets.reserve(num_unary_ops + 1);
+    for (OpID op_id : layered_op_ids) {
+        const UnaryOperator &op = unary_operators[op_id];
+        layered_effects.push_back(op.effect);
+        layered_base_costs.push_back(op.base_cost);
+        layered_precondition_offsets.push_back(layered_preconditions.size());
+        for (PropID precond : get_preconditions(op_id))
+            layered_preconditions.push_back(precond);
+    }
+    layered_precondition_offsets.push_back(layered_preconditions.size());
+    layered_costs.resize(num_propositions);
+    layered_reached_by.resize(num_propositions);
+}
+
+void RelaxationHeuristic::compute_costs_layered(
+    const State &state, bool use_max) {
+    fill(layered_costs.begin(), layered_costs.end(), INFINITE_COST);
+    fill(layered_reached_by.begin(), layered_reached_by.end(), NO_OP);
+    for (FactProxy fact : state)
+        layered_costs[get_prop_id(fact)] = 0;
+
+    /*
+      Costs only ever decrease, and a cost is only lowered with
+      operators whose preconditions are reached, so the achievers form
+      an acyclic graph as in the queue-based exploration.
+    */
+    const int *costs = layered_costs.data();
+    const PropID *preconditions = layered_preconditions.data();
+    int num_ops = layered_effects.size();
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < num_ops; ++i) {
+            int begin = layered_precondition_offsets[i];
+            int end = layered_precondition_offsets[i + 1];
+            // Unreached preconditions make the cost at least INFINITE_COST.
+            int64_t cost = 0;
+            if (use_max) {
+                for (int j = begin; j < end; ++j)
+                    cost = max<int64_t>(cost, costs[preconditions[j]]);
+            } else {
+                for (int j = begin; j < end; ++j)
+                    cost += costs[preconditions[j]];
+            }
+            if (cost >= INFINITE_COST)
+                continue;
+            cost += layered_base_costs[i];
+            if (!use_max && cost > MAX_COST_VALUE)
+                cost = MAX_COST_VALUE;
+            PropID effect = layered_effects[i];
+            if (cost < layered_costs[effect]) {
+                layered_costs[effect] = cost;
+                layered_reached_by[effect] = layered_op_ids[i];
+                changed = true;
+            }
+        }
+    }
+
+    int num_propositions = propositions.size();
+    for (PropID prop_id = 0; prop_id < num_propositions; ++prop_id) {
+        Proposition &prop = propositions[prop_id];
+        int cost = layered_costs[prop_id];
+        prop.cost = (cost == INFINITE_COST) ? -1 : cost;
+        prop.reached_by = layered_reached_by[prop_id];
+    }
+}
+
+void RelaxationHeuristic::explore_to_fixpoint(
+    const State &state, bool use_max) {
+    if (exploration == Exploration::INCREMENTAL) {
+        compute_costs_incrementally(state, use_max);
+    } else {
+        assert(exploration == Exploration::LAYERED);
+        compute_costs_layered(state, use_max);
+    }
+}
+
 PropID RelaxationHeuristic::get_prop_id(int var, int value) const {
     return proposition_offsets[var] + value;
 }
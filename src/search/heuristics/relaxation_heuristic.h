@@ -5,6 +5,8 @@
 
 #include "../heuristic.h"
 
+#include "../algorithms/priority_queues.h"
+
 #include "../utils/collections.h"
 
 #include <cassert>
@@ -13,6 +15,7 @@
 class FactProxy;
 class GlobalState;
 class OperatorProxy;
+class State;
 
 namespace relaxation_heuristic {
 struct Proposition;
@@ -55,13 +58,90 @@ struct UnaryOperator {
 
 static_assert(sizeof(UnaryOperator) == 28, "UnaryOperator has wrong size");
 
+enum class Exploration {
+    QUEUE,
+    INCREMENTAL,
+    LAYERED
+};
+
 class RelaxationHeuristic : public Heuristic {
     void build_unary_operators(const OperatorProxy &op);
     void simplify();
 
     // proposition_offsets[var_no]: first PropID related to variable var_no
     std::vector<PropID> proposition_offsets;
+
+    /*
+      Data for the incremental exploration. achievers[prop_id] holds the
+      unary operators with effect prop_id. explored_state_values is the
+      state for which the proposition costs currently hold the fixpoint
+      (empty if there is no such state).
+    */
+    std::vector<std::vector<OpID>> achievers;
+    std::vector<int> explored_state_values;
+    std::vector<PropID> added_propositions;
+    std::vector<PropID> affected_propositions;
+    std::vector<bool> is_affected;
+    priority_queues::AdaptiveQueue<PropID> incremental_queue;
+
+    void mark_affected(PropID prop_id);
+    void clear_affected_propositions();
+    void relax_operator(OpID op_id, bool use_max);
+    void propagate_cost_decreases(bool use_max);
+    void recompute_costs_from_scratch(const State &state, bool use_max);
+
+    /*
+      Incremental exploration: instead of exploring from scratch, repair
+      the costs of the previously explored state. Removed facts and all
+      propositions whose cheapest achiever (reached_by) transitively
+      depends on them are reset and reseeded from their remaining
+      achievers, then added facts and reseeded propositions propagate
+      cost decreases Dijkstra-style. If the states differ in many facts
+      or the cone is large, we explore from scratch instead.
+    */
+    void compute_costs_incrementally(const State &state, bool use_max);
+
+    /*
+      Data for the layered exploration: a struct-of-arrays copy of the
+      unary operators with the preconditions stored contiguously in
+      operator order. Operators are sorted by the layer of the relaxed
+      planning graph of the initial state in which they first become
+      applicable, so that a single pass usually propagates costs along
+      long chains of operators. The costs and achievers of the
+      propositions are kept in separate arrays (INFINITE_COST for
+      unreached propositions) and copied to the propositions at the end.
+    */
+    std::vector<OpID> layered_op_ids;
+    std::vector<PropID> layered_effects;
+    std::vector<int> layered_base_costs;
+    std::vector<int> layered_precondition_offsets;
+    std::vector<PropID> layered_preconditions;
+    std::vector<int> layered_costs;
+    std::vector<OpID> layered_reached_by;
+
+    void build_layered_operators();
+
+    /*
+      Layered exploration: sweep over all operators in the order above
+      and lower the cost of their effects until no cost changes
+      (Bellman-Ford style). Each sweep only reads and writes flat int
+      arrays and its loops have no data-dependent exits, so the compiler
+      can vectorize and unroll them. This is faster than the queue if
+      operators have many preconditions and few sweeps are needed.
+    */
+    void compute_costs_layered(const State &state, bool use_max);
 protected:
+    /* Costs larger than MAX_COST_VALUE are clamped to max_value. The
+       precise value (100M) is a bit of a hack, since other parts of
+       the code don't reliably check against overflow as of this
+       writing. With a value of 100M, we want to ensure that even
+       weighted A* with a weight of 10 will have f values comfortably
+       below the signed 32-bit int upper bound.
+     */
+    static const int MAX_COST_VALUE = 100000000;
+
+    const Exploration exploration;
+
     std::vector<UnaryOperator> unary_operators;
     std::vector<Proposition> propositions;
     std::vector<PropID> goal_propositions;
@@ -110,9 +190,23 @@ protected:
     const Proposition *get_proposition(int var, int value) const;
     Proposition *get_proposition(int var, int value);
     Proposition *get_proposition(const FactProxy &fact);
+
+    /*
+      Run the incremental or layered exploration (depending on the
+      exploration option, which must not be QUEUE). Both explore to the
+      fixpoint, so the resulting proposition costs are the h^max costs
+      (if use_max is true) or h^add costs of all propositions and
+      reached_by is set for all reached propositions. Facts of the state
+      are never reached by an operator. The cost and
+      unsatisfied_preconditions fields of the unary operators are not
+      meaningful afterwards.
+    */
+    void explore_to_fixpoint(const State &state, bool use_max);
 public:
     explicit RelaxationHeuristic(const options::Options &options);
 
+    static void add_options_to_parser(options::OptionParser &parser);
+
     virtual bool dead_ends_are_reliable() const override;
 };
 }
@@ -2,9 +2,7 @@
 
 #include "util.h"
 
-#include "../task_utils/task_properties.h"
-#include "../utils/collections.h"
-#include "../utils/hash.h"
+#include "../algorithms/priority_queues.h"
 
 #include <algorithm>
 #include <cassert>
@@ -18,8 +16,7 @@ namespace landmarks {
    - Added-on functionality for excluding certain operators from the relaxed
      exploration (these operators are never applied, as necessary for landmark
      computation)
-   - Exploration can be done either using h_max or h_add criterion (h_max is needed
-     during landmark generation, h_add later for heuristic computations)
+   - Only h_max values are computed (they are needed during landmark generation)
    - Unary operators are not simplified, because this may conflict with excluded
      operators. (For an example, consider that unary operator o1 is thrown out
      during simplify() because it is dominated by unary operator o2, but then o2
@@ -30,29 +27,25 @@ namespace landmarks {
      proposition (needed for planning to nearest landmark).
 */
 
-// Construction and destruction
 Exploration::Exploration(const TaskProxy &task_proxy)
-    : task_proxy(task_proxy),
-      did_write_overflow_warning(false) {
+    : task_proxy(task_proxy) {
     cout << "Initializing Exploration..." << endl;
 
     // Build propositions.
     for (VariableProxy var : task_proxy.get_variables()) {
         int var_id = var.get_id();
-        propositions.push_back(vector<ExProposition>(var.get_domain_size()));
+        proposition_offsets.push_back(propositions.size());
         for (int value = 0; value < var.get_domain_size(); ++value) {
-            propositions[var_id][value].fact = FactPair(var_id, value);
+            propositions.emplace_back(FactPair(var_id, value));
         }
     }
 
     // Build goal propositions.
     for (FactProxy goal_fact : task_proxy.get_goals()) {
-        int var_id = goal_fact.get_variable().get_id();
-        int value = goal_fact.get_value();
-        propositions[var_id][value].is_goal_condition = true;
-        propositions[var_id][value].is_termination_condition = true;
-        goal_propositions.push_back(&propositions[var_id][value]);
-        termination_propositions.push_back(&propositions[var_id][value]);
+        int prop_id = get_proposition_id(
+            goal_fact.get_variable().get_id(), goal_fact.get_value());
+        propositions[prop_id].is_termination_condition = true;
+        termination_propositions.push_back(prop_id);
     }
 
     // Build unary operators for operators and axioms.
@@ -64,36 +57,16 @@ Exploration::Exploration(const TaskProxy &task_proxy)
         build_unary_operators(op);
 
     // Cross-reference unary operators.
-    for (ExUnaryOperator &op : unary_operators) {
-        for (ExProposition *pre : op.precondition)
-            pre->precondition_of.push_back(&op);
-    }
-}
-
-void Exploration::increase_cost(int &cost, int amount) {
-    assert(cost >= 0);
-    assert(amount >= 0);
-    cost += amount;
-    if (cost > MAX_COST_VALUE) {
-        write_overflow_warning();
-        cost = MAX_COST_VALUE;
-    }
-}
-
-void Exploration::write_overflow_warning() {
-    if (!did_write_overflow_warning) {
-        // TODO: Should have a planner-wide warning mechanism to handle
-        // things like this.
-        cout << "WARNING: overflow on landmark exploration h^add! Costs clamped to "
-             << MAX_COST_VALUE << endl;
-        did_write_overflow_warning = true;
+    for (size_t op_id = 0; op_id < unary_operators.size(); ++op_id) {
+        for (int pre : unary_operators[op_id].precondition)
+            propositions[pre].precondition_of.push_back(op_id);
     }
 }
 
 void Exploration::build_unary_operators(const OperatorProxy &op) {
     // Note: changed from the original to allow sorting of operator conditions
     int base_cost = op.get_cost();
-    vector<ExProposition *> precondition;
+    vector<int> precondition;
     vector<FactPair> precondition_facts1;
 
     for (FactProxy pre : op.get_preconditions()) {
@@ -109,11 +82,12 @@ void Exploration::build_unary_operators(const OperatorProxy &op) {
         sort(precondition_facts2.begin(), precondition_facts2.end());
 
         for (const FactPair &precondition_fact : precondition_facts2)
-            precondition.push_back(&propositions[precondition_fact.var]
-                                   [precondition_fact.value]);
+            precondition.push_back(get_proposition_id(
+                                       precondition_fact.var, precondition_fact.value));
 
         FactProxy effect_fact = effect.get_fact();
-        ExProposition *effect_proposition = &propositions[effect_fact.get_variable().get_id()][effect_fact.get_value()];
+        int effect_proposition = get_proposition_id(
+            effect_fact.get_variable().get_id(), effect_fact.get_value());
         int op_or_axiom_id = get_operator_or_axiom_id(op);
         unary_operators.emplace_back(precondition, effect_proposition, op_or_axiom_id, base_cost);
         precondition.clear();
@@ -121,158 +95,114 @@ void Exploration::build_unary_operators(const OperatorProxy &op) {
     }
 }
 
-// heuristic computation
-void Exploration::setup_exploration_queue(const State &state,
-                                          const vector<FactPair> &excluded_props,
-                                          const unordered_set<int> &excluded_op_ids,
-                                          bool use_h_max) {
-    prop_queue.clear();
-
-    for (size_t var_id = 0; var_id < propositions.size(); ++var_id) {
-        for (size_t value = 0; value < propositions[var_id].size(); ++value) {
-            ExProposition &prop = propositions[var_id][value];
-            prop.h_add_cost = -1;
-            prop.h_max_cost = -1;
-            prop.depth = -1;
-            prop.marked = false;
-        }
-    }
+void Exploration::compute_reachability_with_excludes(vector<vector<int>> &lvl_var,
+                                                     vector<utils::HashMap<FactPair, int>> &lvl_op,
+                                                     bool level_out,
+                                                     const vector<FactPair> &excluded_props,
+                                                     const unordered_set<int> &excluded_op_ids,
+                                                     bool compute_lvl_ops) const {
+    /*
+      Perform exploration using h_max-values. A cost of -1 means that the
+      proposition has not been reached (yet).
+    */
+    vector<int> prop_costs(propositions.size(), -1);
+    vector<int> op_costs(unary_operators.size());
+    vector<int> unsatisfied_preconditions(unary_operators.size());
+    // Excluded operators are never applied during the relaxed exploration.
+    vector<bool> is_excluded_op(unary_operators.size(), false);
+    priority_queues::AdaptiveQueue<int> prop_queue;
+
+    auto enqueue_if_necessary = [&] (int prop_id, int cost) {
+            assert(cost >= 0);
+            if (prop_costs[prop_id] == -1 || prop_costs[prop_id] > cost) {
+                prop_costs[prop_id] = cost;
+                prop_queue.push(cost, prop_id);
+            }
+        };
 
-    for (const FactPair &fact : excluded_props) {
-        ExProposition &prop = propositions[fact.var][fact.value];
-        prop.h_add_cost = -2;
+    vector<bool> is_excluded_prop;
+    if (!excluded_op_ids.empty()) {
+        is_excluded_prop.resize(propositions.size(), false);
+        for (const FactPair &fact : excluded_props)
+            is_excluded_prop[get_proposition_id(fact.var, fact.value)] = true;
     }
 
     // Deal with current state.
-    for (FactProxy fact : state) {
-        ExProposition *init_prop = &propositions[fact.get_variable().get_id()][fact.get_value()];
-        enqueue_if_necessary(init_prop, 0, 0, 0, use_h_max);
+    for (FactProxy fact : task_proxy.get_initial_state()) {
+        enqueue_if_necessary(
+            get_proposition_id(fact.get_variable().get_id(), fact.get_value()), 0);
     }
 
     // Initialize operator data, deal with precondition-free operators/axioms.
-    for (ExUnaryOperator &op : unary_operators) {
-        op.unsatisfied_preconditions = op.precondition.size();
+    for (size_t op_id = 0; op_id < unary_operators.size(); ++op_id) {
+        const ExUnaryOperator &op = unary_operators[op_id];
+        unsatisfied_preconditions[op_id] = op.precondition.size();
+        op_costs[op_id] = op.base_cost; // will be increased by precondition costs
         if (!excluded_op_ids.empty() &&
-            (op.effect->h_add_cost == -2 || excluded_op_ids.count(op.op_or_axiom_id))) {
-            op.h_add_cost = -2; // operator will not be applied during relaxed exploration
+            (is_excluded_prop[op.effect] || excluded_op_ids.count(op.op_or_axiom_id))) {
+            is_excluded_op[op_id] = true;
             continue;
         }
-        op.h_add_cost = op.base_cost; // will be increased by precondition costs
-        op.h_max_cost = op.base_cost;
-        op.depth = -1;
 
-        if (op.unsatisfied_preconditions == 0) {
-            op.depth = 0;
-            int depth = op.is_induced_by_axiom(task_proxy) ? 0 : 1;
-            enqueue_if_necessary(op.effect, op.base_cost, depth, &op, use_h_max);
+        if (unsatisfied_preconditions[op_id] == 0) {
+            enqueue_if_necessary(op.effect, op.base_cost);
         }
     }
-}
 
-void Exploration::relaxed_exploration(bool use_h_max, bool level_out) {
     int unsolved_goals = termination_propositions.size();
     while (!prop_queue.empty()) {
-        pair<int, ExProposition *> top_pair = prop_queue.pop();
+        pair<int, int> top_pair = prop_queue.pop();
         int distance = top_pair.first;
-        ExProposition *prop = top_pair.second;
+        int prop_id = top_pair.second;
 
-        int prop_cost;
-        if (use_h_max)
-            prop_cost = prop->h_max_cost;
-        else
-            prop_cost = prop->h_add_cost;
+        int prop_cost = prop_costs[prop_id];
         assert(prop_cost <= distance);
         if (prop_cost < distance)
             continue;
-        if (!level_out && prop->is_termination_condition && --unsolved_goals == 0)
-            return;
-        const vector<ExUnaryOperator *> &triggered_operators = prop->precondition_of;
-        for (size_t i = 0; i < triggered_operators.size(); ++i) {
-            ExUnaryOperator *unary_op = triggered_operators[i];
-            if (unary_op->h_add_cost == -2) // operator is not applied
+        const ExProposition &prop = propositions[prop_id];
+        if (!level_out && prop.is_termination_condition && --unsolved_goals == 0)
+            break;
+        for (int op_id : prop.precondition_of) {
+            if (is_excluded_op[op_id])
                 continue;
-            --unary_op->unsatisfied_preconditions;
-            increase_cost(unary_op->h_add_cost, prop_cost);
-            unary_op->h_max_cost = max(prop_cost + unary_op->base_cost,
-                                       unary_op->h_max_cost);
-            unary_op->depth = max(unary_op->depth, prop->depth);
-            assert(unary_op->unsatisfied_preconditions >= 0);
-            if (unary_op->unsatisfied_preconditions == 0) {
-                int depth = unary_op->is_induced_by_axiom(task_proxy)
-                    ? unary_op->depth : unary_op->depth + 1;
-                if (use_h_max)
-                    enqueue_if_necessary(unary_op->effect, unary_op->h_max_cost,
-                                         depth, unary_op, use_h_max);
-                else
-                    enqueue_if_necessary(unary_op->effect, unary_op->h_add_cost,
-                                         depth, unary_op, use_h_max);
-            }
+            const ExUnaryOperator &unary_op = unary_operators[op_id];
+            --unsatisfied_preconditions[op_id];
+            op_costs[op_id] = max(prop_cost + unary_op.base_cost, op_costs[op_id]);
+            assert(unsatisfied_preconditions[op_id] >= 0);
+            if (unsatisfied_preconditions[op_id] == 0)
+                enqueue_if_necessary(unary_op.effect, op_costs[op_id]);
         }
     }
-}
-
-void Exploration::enqueue_if_necessary(ExProposition *prop, int cost, int depth,
-                                       ExUnaryOperator *op,
-                                       bool use_h_max) {
-    assert(cost >= 0);
-    if (use_h_max && (prop->h_max_cost == -1 || prop->h_max_cost > cost)) {
-        prop->h_max_cost = cost;
-        prop->depth = depth;
-        prop->reached_by = op;
-        prop_queue.push(cost, prop);
-    } else if (!use_h_max && (prop->h_add_cost == -1 || prop->h_add_cost > cost)) {
-        prop->h_add_cost = cost;
-        prop->depth = depth;
-        prop->reached_by = op;
-        prop_queue.push(cost, prop);
-    }
-    if (use_h_max)
-        assert(prop->h_max_cost != -1 &&
-               prop->h_max_cost <= cost);
-    else
-        assert(prop->h_add_cost != -1 &&
-               prop->h_add_cost <= cost);
-}
-
-void Exploration::compute_reachability_with_excludes(vector<vector<int>> &lvl_var,
-                                                     vector<utils::HashMap<FactPair, int>> &lvl_op,
-                                                     bool level_out,
-                                                     const vector<FactPair> &excluded_props,
-                                                     const unordered_set<int> &excluded_op_ids,
-                                                     bool compute_lvl_ops) {
-    // Perform exploration using h_max-values
-    setup_exploration_queue(task_proxy.get_initial_state(), excluded_props, excluded_op_ids, true);
-    relaxed_exploration(true, level_out);
 
     // Copy reachability information into lvl_var and lvl_op
-    for (size_t var_id = 0; var_id < propositions.size(); ++var_id) {
-        for (size_t value = 0; value < propositions[var_id].size(); ++value) {
-            ExProposition &prop = propositions[var_id][value];
-            if (prop.h_max_cost >= 0)
-                lvl_var[var_id][value] = prop.h_max_cost;
-        }
+    for (size_t prop_id = 0; prop_id < propositions.size(); ++prop_id) {
+        const FactPair &fact = propositions[prop_id].fact;
+        if (prop_costs[prop_id] >= 0)
+            lvl_var[fact.var][fact.value] = prop_costs[prop_id];
     }
     if (compute_lvl_ops) {
-        for (ExUnaryOperator &op : unary_operators) {
+        for (size_t op_id = 0; op_id < unary_operators.size(); ++op_id) {
+            const ExUnaryOperator &op = unary_operators[op_id];
+            int &op_cost = op_costs[op_id];
             // H_max_cost of operator might be wrongly 0 or 1, if the operator
             // did not get applied during relaxed exploration. Look through
             // preconditions and adjust.
-            for (ExProposition *prop : op.precondition) {
-                if (prop->h_max_cost == -1) {
+            for (int pre : op.precondition) {
+                if (prop_costs[pre] == -1) {
                     // Operator cannot be applied due to unreached precondition
-                    op.h_max_cost = numeric_limits<int>::max();
+                    op_cost = numeric_limits<int>::max();
                     break;
-                } else if (op.h_max_cost < prop->h_max_cost + op.base_cost)
-                    op.h_max_cost = prop->h_max_cost + op.base_cost;
+                } else if (op_cost < prop_costs[pre] + op.base_cost)
+                    op_cost = prop_costs[pre] + op.base_cost;
             }
-            if (op.h_max_cost == numeric_limits<int>::max())
+            if (op_cost == numeric_limits<int>::max())
                 break;
             // We subtract 1 to keep semantics for landmark code:
             // if op can achieve prop at time step i+1,
             // its index (for prop) is i, where the initial state is time step 0.
-            const FactPair &effect = op.effect->fact;
+            const FactPair &effect = propositions[op.effect].fact;
             assert(lvl_op[op.op_or_axiom_id].count(effect));
-            int new_lvl = op.h_max_cost - 1;
+            int new_lvl = op_cost - 1;
             // If we have found a cheaper achieving operator, adjust h_max cost of proposition.
             if (lvl_op[op.op_or_axiom_id].find(effect)->second > new_lvl)
                 lvl_op[op.op_or_axiom_id].find(effect)->second = new_lvl;
@@ -454,24 +454,58 @@ LandmarkEfficientOptimalSharedCostAssignment::LandmarkEfficientOptimalSharedCost
     lp::LPSolverType solver_type)
     : LandmarkCostAssignment(operator_costs, graph),
       lp_solver(solver_type) {
-    /* The LP has one variable (column) per landmark and one
-       inequality (row) per operator. */
-    int num_cols = lm_graph.number_of_landmarks();
-    int num_rows = operator_costs.size();
-
-    /* We want to maximize 1 * cost(lm_1) + ... + 1 * cost(lm_n),
-       so the coefficients are all 1.
-       Variable bounds are state-dependent; we initialize the range to {0}. */
-    lp_variables.resize(num_cols, lp::LPVariable(0.0, 0.0, 1.0));
+    /*
+      The LP has one inequality (row) per operator and two variables
+      (columns) per landmark: cost(lm) if lm is not reached and cost'(lm)
+      if lm is needed again. The constraints are of the form
+        cost(lm_i1) + ... + cost(lm_in) + cost'(lm_j1) + ... + cost'(lm_jm) <= cost(o)
+      where lm_i1 ... lm_in are the landmarks for which o is a first
+      achiever and lm_j1 ... lm_jm are the landmarks for which o is a
+      possible achiever. Since the relevant achievers only depend on the
+      landmark status, the coefficient matrix is the same for all states.
+      We want to maximize the sum of all variables. Variable bounds are
+      state-dependent: the variable matching the status of a landmark has
+      the range [0, infinity], all others have the range {0}.
+    */
+    int num_landmarks = lm_graph.number_of_landmarks();
+    vector<lp::LPVariable> lp_variables(
+        2 * num_landmarks, lp::LPVariable(0.0, 0.0, 1.0));
 
-    /* Set up lower bounds and upper bounds for the inequalities.
-       These simply say that the operator's total cost must fall
-       between 0 and the real operator cost. */
-    lp_constraints.resize(num_rows, lp::LPConstraint(0.0, 0.0));
+    vector<lp::LPConstraint> lp_constraints(
+        operator_costs.size(), lp::LPConstraint(0.0, 0.0));
     for (size_t op_id = 0; op_id < operator_costs.size(); ++op_id) {
-        lp_constraints[op_id].set_lower_bound(0);
         lp_constraints[op_id].set_upper_bound(operator_costs[op_id]);
     }
+    for (int lm_id = 0; lm_id < num_landmarks; ++lm_id) {
+        const LandmarkNode *lm = lm_graph.get_lm_for_index(lm_id);
+        for (int lm_status : {lm_not_reached, lm_needed_again}) {
+            int var = get_lp_variable(lm_id, lm_status);
+            for (int op_id : get_achievers(lm_status, *lm)) {
+                assert(utils::in_bounds(op_id, lp_constraints));
+                lp_constraints[op_id].insert(var, 1.0);
+            }
+        }
+    }
+
+    /* Only use non-empty constraints in the LP.
+       This significantly speeds up the heuristic calculation. See issue443. */
+    vector<lp::LPConstraint> non_empty_lp_constraints;
+    for (const lp::LPConstraint &constraint : lp_constraints) {
+        if (!constraint.empty())
+            non_empty_lp_constraints.push_back(constraint);
+    }
+    lp_solver.load_problem(lp::LPObjectiveSense::MAXIMIZE,
+                           lp_variables, non_empty_lp_constraints);
+    lp_lm_statuses.resize(num_landmarks, lm_reached);
+}
+
+int LandmarkEfficientOptimalSharedCostAssignment::get_lp_variable(
+    int lm_id, int lm_status) const {
+    assert(lm_status == lm_not_reached || lm_status == lm_needed_again);
+    if (lm_status == lm_not_reached)
+        return lm_id;
+    else
+        return lm_graph.number_of_landmarks() + lm_id;
 }
 
 
@@ -480,60 +514,29 @@ double LandmarkEfficientOptimalSharedCostAssignment::cost_sharing_h_value() {
              do in the uniform cost partitioning case. */
 
     /*
-      Set up LP variable bounds for the landmarks.
-      The range of cost(lm_1) is {0} if the landmark is already
-      reached; otherwise it is [0, infinity].
-      The lower bounds are set to 0 in the constructor and never change.
-    */
-    int num_cols = lm_graph.number_of_landmarks();
-    for (int lm_id = 0; lm_id < num_cols; ++lm_id) {
-        const LandmarkNode *lm = lm_graph.get_lm_for_index(lm_id);
-        if (lm->get_status() == lm_reached) {
-            lp_variables[lm_id].upper_bound = 0;
-        } else {
-            lp_variables[lm_id].upper_bound = lp_solver.get_infinity();
-        }
-    }
-
-    /*
-      Define the constraint matrix. The constraints are of the form
-      cost(lm_i1) + cost(lm_i2) + ... + cost(lm_in) <= cost(o)
-      where lm_i1 ... lm_in are the landmarks for which o is a
-      relevant achiever. Hence, we add a triple (op, lm, 1.0)
-      for each relevant achiever op of landmark lm, denoting that
-      in the op-th row and lm-th column, the matrix has a 1.0 entry.
+      Adapt the variable bounds to the landmark statuses. The lower bounds
+      are 0 and never change.
     */
-    // Reuse previous constraint objects to save the effort of recreating them.
-    for (lp::LPConstraint &constraint : lp_constraints) {
-        constraint.clear();
-    }
-    for (int lm_id = 0; lm_id < num_cols; ++lm_id) {
+    int num_landmarks = lm_graph.number_of_landmarks();
+    for (int lm_id = 0; lm_id < num_landmarks; ++lm_id) {
         const LandmarkNode *lm = lm_graph.get_lm_for_index(lm_id);
         int lm_status = lm->get_status();
+        int &lp_lm_status = lp_lm_statuses[lm_id];
+        if (lm_status == lp_lm_status)
+            continue;
+        if (lp_lm_status != lm_reached) {
+            lp_solver.set_variable_upper_bound(
+                get_lp_variable(lm_id, lp_lm_status), 0);
+        }
         if (lm_status != lm_reached) {
-            const set<int> &achievers = get_achievers(lm_status, *lm);
-            assert(!achievers.empty());
-            for (int op_id : achievers) {
-                assert(utils::in_bounds(op_id, lp_constraints));
-                lp_constraints[op_id].insert(lm_id, 1.0);
-            }
+            assert(!get_achievers(lm_status, *lm).empty());
+            lp_solver.set_variable_upper_bound(
+                get_lp_variable(lm_id, lm_status), lp_solver.get_infinity());
         }
+        lp_lm_status = lm_status;
     }
 
-    /* Copy non-empty constraints and use those in the LP.
-       This significantly speeds up the heuristic calculation. See issue443. */
-    // TODO: do not copy the data here.
-    non_empty_lp_constraints.clear();
-    for (const lp::LPConstraint &constraint : lp_constraints) {
-        if (!constraint.empty())
-            non_empty_lp_constraints.push_back(constraint);
-    }
-
-    // Load the problem into the LP solver.
-    lp_solver.load_problem(lp::LPObjectiveSense::MAXIMIZE,
-                           lp_variables, non_empty_lp_constraints);
-
-    // Solve the linear program.
+    // Solve the linear program, starting from the previous solution.
     lp_solver.solve();
 
     assert(lp_solver.has_optimal_solution());
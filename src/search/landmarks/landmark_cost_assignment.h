@@ -95,14 +95,14 @@ public:
 class LandmarkEfficientOptimalSharedCostAssignment : public LandmarkCostAssignment {
     lp::LPSolver lp_solver;
     /*
-      We keep the vectors for LP variables and constraints around instead of
-      recreating them for every state. The actual constraints have to be
-      recreated because the coefficient matrix of the LP changes from state to
-      state. Reusing the vectors still saves some dynamic allocation overhead.
-     */
-    std::vector<lp::LPVariable> lp_variables;
-    std::vector<lp::LPConstraint> lp_constraints;
-    std::vector<lp::LPConstraint> non_empty_lp_constraints;
+      The LP is loaded once and only the variable bounds change between
+      states, so the solver can warm-start from the previous basis. We
+      store the landmark statuses of the last LP to only update the bounds
+      of landmarks whose status changed.
+    */
+    std::vector<int> lp_lm_statuses;
+
+    int get_lp_variable(int lm_id, int lm_status) const;
 public:
     LandmarkEfficientOptimalSharedCostAssignment(const std::vector<int> &operator_costs,
                                                  const LandmarkGraph &graph,
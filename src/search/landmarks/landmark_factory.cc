@@ -56,13 +56,21 @@ shared_ptr<LandmarkGraph> LandmarkFactory::compute_lm_graph(
         }
         return lm_graph;
     }
+    TaskProxy task_proxy(*task);
+    Exploration exploration(task_proxy);
+    return compute_lm_graph(task, exploration);
+}
+
+shared_ptr<LandmarkGraph> LandmarkFactory::compute_lm_graph(
+    const shared_ptr<AbstractTask> &task, const Exploration &exploration) {
+    if (lm_graph)
+        return compute_lm_graph(task);
     lm_graph_task = task.get();
     utils::Timer lm_generation_timer;
 
     TaskProxy task_proxy(*task);
 
     lm_graph = make_shared<LandmarkGraph>(task_proxy);
-    Exploration exploration(task_proxy);
     generate_landmarks(task, exploration);
 
     // the following replaces the old "build_lm_graph"
@@ -81,7 +89,7 @@ shared_ptr<LandmarkGraph> LandmarkFactory::compute_lm_graph(
     return lm_graph;
 }
 
-void LandmarkFactory::generate(const TaskProxy &task_proxy, Exploration &exploration) {
+void LandmarkFactory::generate(const TaskProxy &task_proxy, const Exploration &exploration) {
     if (only_causal_landmarks)
         discard_noncausal_landmarks(task_proxy, exploration);
     if (!disjunctive_landmarks)
@@ -135,7 +143,7 @@ bool LandmarkFactory::is_landmark_precondition(const OperatorProxy &op,
 }
 
 bool LandmarkFactory::relaxed_task_solvable(const TaskProxy &task_proxy,
-                                            Exploration &exploration,
+                                            const Exploration &exploration,
                                             vector<vector<int>> &lvl_var,
                                             vector<utils::HashMap<FactPair, int>> &lvl_op,
                                             bool level_out, const LandmarkNode *exclude, bool compute_lvl_op) const {
@@ -195,7 +203,7 @@ void LandmarkFactory::add_operator_and_propositions_to_list(const OperatorProxy
     }
 }
 
-bool LandmarkFactory::is_causal_landmark(const TaskProxy &task_proxy, Exploration &exploration,
+bool LandmarkFactory::is_causal_landmark(const TaskProxy &task_proxy, const Exploration &exploration,
                                          const LandmarkNode &landmark) const {
     /* Test whether the relaxed planning task is unsolvable without using any operator
        that has "landmark" has a precondition.
@@ -605,7 +613,7 @@ void LandmarkFactory::edge_add(LandmarkNode &from, LandmarkNode &to,
     assert(to.parents.find(&from) != to.parents.end());
 }
 
-void LandmarkFactory::discard_noncausal_landmarks(const TaskProxy &task_proxy, Exploration &exploration) {
+void LandmarkFactory::discard_noncausal_landmarks(const TaskProxy &task_proxy, const Exploration &exploration) {
     int num_all_landmarks = lm_graph->number_of_landmarks();
     lm_graph->remove_node_if(
         [this, &task_proxy, &exploration](const LandmarkNode &node) {
@@ -758,7 +766,7 @@ int LandmarkFactory::calculate_lms_cost() const {
 
 void LandmarkFactory::compute_predecessor_information(
     const TaskProxy &task_proxy,
-    Exploration &exploration,
+    const Exploration &exploration,
     LandmarkNode *bp,
     vector<vector<int>> &lvl_var,
     vector<utils::HashMap<FactPair, int>> &lvl_op) {
@@ -769,7 +777,7 @@ void LandmarkFactory::compute_predecessor_information(
     relaxed_task_solvable(task_proxy, exploration, lvl_var, lvl_op, true, bp);
 }
 
-void LandmarkFactory::calc_achievers(const TaskProxy &task_proxy, Exploration &exploration) {
+void LandmarkFactory::calc_achievers(const TaskProxy &task_proxy, const Exploration &exploration) {
     VariablesProxy variables = task_proxy.get_variables();
     for (auto &lmn : lm_graph->get_nodes()) {
         for (const FactPair &lm_fact : lmn->facts) {
@@ -32,6 +32,13 @@ public:
     LandmarkFactory(const LandmarkFactory &) = delete;
 
     std::shared_ptr<LandmarkGraph> compute_lm_graph(const std::shared_ptr<AbstractTask> &task);
+    /*
+      Same as above, but use the given exploration (which must belong to
+      the same task) instead of building a new one. The exploration is
+      only read, so factories running in parallel can share it.
+    */
+    std::shared_ptr<LandmarkGraph> compute_lm_graph(
+        const std::shared_ptr<AbstractTask> &task, const Exploration &exploration);
 
     bool use_disjunctive_landmarks() const {return disjunctive_landmarks;}
     bool use_reasonable_orders() const {return reasonable_orders;}
@@ -43,13 +50,13 @@ protected:
 
     bool use_orders() const {return !no_orders;}   // only needed by HMLandmark
 
-    virtual void generate_landmarks(const std::shared_ptr<AbstractTask> &task, Exploration &exploration) = 0;
-    void generate(const TaskProxy &task_proxy, Exploration &exploration);
-    void discard_noncausal_landmarks(const TaskProxy &task_proxy, Exploration &exploration);
+    virtual void generate_landmarks(const std::shared_ptr<AbstractTask> &task, const Exploration &exploration) = 0;
+    void generate(const TaskProxy &task_proxy, const Exploration &exploration);
+    void discard_noncausal_landmarks(const TaskProxy &task_proxy, const Exploration &exploration);
     void discard_disjunctive_landmarks();
     void discard_conjunctive_landmarks();
     void discard_all_orderings();
-    inline bool relaxed_task_solvable(const TaskProxy &task_proxy, Exploration &exploration,
+    inline bool relaxed_task_solvable(const TaskProxy &task_proxy, const Exploration &exploration,
                                       bool level_out,
                                       const LandmarkNode *exclude,
                                       bool compute_lvl_op = false) const {
@@ -59,7 +66,7 @@ protected:
     }
     void edge_add(LandmarkNode &from, LandmarkNode &to, EdgeType type);
     void compute_predecessor_information(const TaskProxy &task_proxy,
-                                         Exploration &exploration,
+                                         const Exploration &exploration,
                                          LandmarkNode *bp,
                                          std::vector<std::vector<int>> &lvl_var,
                                          std::vector<utils::HashMap<FactPair, int>> &lvl_op);
@@ -92,7 +99,7 @@ private:
     int calculate_lms_cost() const;
     void collect_ancestors(std::unordered_set<LandmarkNode *> &result, LandmarkNode &node,
                            bool use_reasonable);
-    bool relaxed_task_solvable(const TaskProxy &task_proxy, Exploration &exploration,
+    bool relaxed_task_solvable(const TaskProxy &task_proxy, const Exploration &exploration,
                                std::vector<std::vector<int>> &lvl_var,
                                std::vector<utils::HashMap<FactPair, int>> &lvl_op,
                                bool level_out,
@@ -100,8 +107,8 @@ private:
                                bool compute_lvl_op = false) const;
     void add_operator_and_propositions_to_list(const OperatorProxy &op,
                                                std::vector<utils::HashMap<FactPair, int>> &lvl_op) const;
-    bool is_causal_landmark(const TaskProxy &task_proxy, Exploration &exploration, const LandmarkNode &landmark) const;
-    virtual void calc_achievers(const TaskProxy &task_proxy, Exploration &exploration); // keep this virtual because HMLandmarks overrides it!
+    bool is_causal_landmark(const TaskProxy &task_proxy, const Exploration &exploration, const LandmarkNode &landmark) const;
+    virtual void calc_achievers(const TaskProxy &task_proxy, const Exploration &exploration); // keep this virtual because HMLandmarks overrides it!
 };
 
 extern void _add_options_to_parser(options::OptionParser &parser);
@@ -447,7 +447,7 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
     FluentSet pc, eff;
     vector<FluentSet> pc_subsets, eff_subsets, noop_pc_subsets, noop_eff_subsets;
 
-    static int op_count = 0;
+    int op_count = 0;
     int set_index, noop_index;
 
     OperatorsProxy operators = task_proxy.get_operators();
@@ -585,7 +585,7 @@ void LandmarkFactoryHM::initialize(const TaskProxy &task_proxy) {
     build_pm_ops(task_proxy);
 }
 
-void LandmarkFactoryHM::calc_achievers(const TaskProxy &task_proxy, Exploration &) {
+void LandmarkFactoryHM::calc_achievers(const TaskProxy &task_proxy, const Exploration &) {
     cout << "Calculating achievers." << endl;
 
     OperatorsProxy operators = task_proxy.get_operators();
@@ -898,7 +898,7 @@ void LandmarkFactoryHM::add_lm_node(int set_index, bool goal) {
 }
 
 void LandmarkFactoryHM::generate_landmarks(
-    const shared_ptr<AbstractTask> &task, Exploration &) {
+    const shared_ptr<AbstractTask> &task, const Exploration &) {
     TaskProxy task_proxy(*task);
     initialize(task_proxy);
     compute_h_m_landmarks(task_proxy);
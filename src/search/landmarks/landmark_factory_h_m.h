@@ -60,7 +60,7 @@ class LandmarkFactoryHM : public LandmarkFactory {
     using TriggerSet = std::unordered_map<int, std::set<int>>;
 
     virtual void generate_landmarks(const std::shared_ptr<AbstractTask> &task,
-                                    Exploration &exploration) override;
+                                    const Exploration &exploration) override;
 
     void compute_h_m_landmarks(const TaskProxy &task_proxy);
     void compute_noop_landmarks(int op_index, int noop_index,
@@ -79,7 +79,7 @@ class LandmarkFactoryHM : public LandmarkFactory {
     bool interesting(const VariablesProxy &variables,
                      const FactPair &fact1,
                      const FactPair &fact2) const;
-    virtual void calc_achievers(const TaskProxy &task_proxy, Exploration &exploration) override;
+    virtual void calc_achievers(const TaskProxy &task_proxy, const Exploration &exploration) override;
 
     void add_lm_node(int set_index, bool goal = false);
 
@@ -7,7 +7,10 @@
 
 #include "../utils/system.h"
 
+#include <algorithm>
+#include <atomic>
 #include <set>
+#include <thread>
 
 using namespace std;
 using utils::ExitCode;
@@ -17,7 +20,8 @@ class LandmarkNode;
 
 LandmarkFactoryMerged::LandmarkFactoryMerged(const Options &opts)
     : LandmarkFactory(opts),
-      lm_factories(opts.get_list<shared_ptr<LandmarkFactory>>("lm_factories")) {
+      lm_factories(opts.get_list<shared_ptr<LandmarkFactory>>("lm_factories")),
+      num_threads(opts.get<int>("num_threads")) {
 }
 
 LandmarkNode *LandmarkFactoryMerged::get_matching_landmark(const LandmarkNode &lm) const {
@@ -40,13 +44,60 @@ LandmarkNode *LandmarkFactoryMerged::get_matching_landmark(const LandmarkNode &l
     return 0;
 }
 
+void LandmarkFactoryMerged::compute_lm_graphs(
+    const shared_ptr<AbstractTask> &task, const Exploration &exploration) {
+    lm_graphs.resize(lm_factories.size());
+    if (num_threads == 1) {
+        for (size_t i = 0; i < lm_factories.size(); ++i) {
+            lm_graphs[i] = lm_factories[i]->compute_lm_graph(task, exploration);
+        }
+        return;
+    }
+
+    /*
+      Factories cache their landmark graph, so a factory that occurs
+      several times in the list must only be run by one thread. Each
+      thread fetches the next unprocessed factory and only writes to the
+      slots of this factory in "lm_graphs". Since the merging below uses
+      the graphs in list order, the result does not depend on the order
+      in which the threads finish.
+    */
+    vector<int> first_occurrence(lm_factories.size());
+    vector<int> unique_factories;
+    for (size_t i = 0; i < lm_factories.size(); ++i) {
+        auto it = find(lm_factories.begin(), lm_factories.end(), lm_factories[i]);
+        first_occurrence[i] = it - lm_factories.begin();
+        if (first_occurrence[i] == static_cast<int>(i))
+            unique_factories.push_back(i);
+    }
+    atomic<int> next_factory(0);
+    int num_workers = min<int>(num_threads, unique_factories.size());
+    vector<thread> workers;
+    workers.reserve(num_workers);
+    for (int worker = 0; worker < num_workers; ++worker) {
+        workers.emplace_back(
+            [this, &task, &exploration, &unique_factories, &next_factory]() {
+                int num_unique = unique_factories.size();
+                for (int i = next_factory++; i < num_unique; i = next_factory++) {
+                    int factory_id = unique_factories[i];
+                    lm_graphs[factory_id] =
+                        lm_factories[factory_id]->compute_lm_graph(task, exploration);
+                }
+            });
+    }
+    for (thread &worker : workers) {
+        worker.join();
+    }
+    for (size_t i = 0; i < lm_factories.size(); ++i) {
+        lm_graphs[i] = lm_graphs[first_occurrence[i]];
+    }
+}
+
 void LandmarkFactoryMerged::generate_landmarks(
-    const shared_ptr<AbstractTask> &task, Exploration &) {
+    const shared_ptr<AbstractTask> &task, const Exploration &exploration) {
     cout << "Merging " << lm_factories.size() << " landmark graphs" << endl;
 
-    for (const shared_ptr<LandmarkFactory> &lm_factory : lm_factories) {
-        lm_graphs.push_back(lm_factory->compute_lm_graph(task));
-    }
+    compute_lm_graphs(task, exploration);
 
     cout << "Adding simple landmarks" << endl;
     for (size_t i = 0; i < lm_graphs.size(); ++i) {
@@ -135,6 +186,15 @@ static shared_ptr<LandmarkFactory> _parse(OptionParser &parser) {
         "Note",
         "Does not currently support conjunctive landmarks");
     parser.add_list_option<shared_ptr<LandmarkFactory>>("lm_factories");
+    parser.add_option<int>(
+        "num_threads",
+        "number of threads for computing the landmark graphs of the "
+        "factories concurrently. The factories share one relaxed "
+        "exploration and their graphs are merged in list order, so the "
+        "result does not depend on this option, but the log output of "
+        "the factories may be interleaved.",
+        "1",
+        Bounds("1", "infinity"));
     _add_options_to_parser(parser);
     Options opts = parser.parse();
 
@@ -12,8 +12,11 @@ class LandmarkNode;
 class LandmarkFactoryMerged : public LandmarkFactory {
     std::vector<std::shared_ptr<LandmarkGraph>> lm_graphs;
     std::vector<std::shared_ptr<LandmarkFactory>> lm_factories;
+    const int num_threads;
 
-    virtual void generate_landmarks(const std::shared_ptr<AbstractTask> &task, Exploration &exploration) override;
+    void compute_lm_graphs(const std::shared_ptr<AbstractTask> &task,
+                           const Exploration &exploration);
+    virtual void generate_landmarks(const std::shared_ptr<AbstractTask> &task, const Exploration &exploration) override;
     LandmarkNode *get_matching_landmark(const LandmarkNode &lm) const;
 public:
     explicit LandmarkFactoryMerged(const options::Options &opts);
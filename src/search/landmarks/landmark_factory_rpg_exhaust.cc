@@ -19,7 +19,7 @@ LandmarkFactoryRpgExhaust::LandmarkFactoryRpgExhaust(const Options &opts)
 }
 
 void LandmarkFactoryRpgExhaust::generate_landmarks(
-    const shared_ptr<AbstractTask> &task, Exploration &exploration) {
+    const shared_ptr<AbstractTask> &task, const Exploration &exploration) {
     TaskProxy task_proxy(*task);
     cout << "Generating landmarks by testing all facts with RPG method" << endl;
 
@@ -6,7 +6,7 @@
 namespace landmarks {
 class LandmarkFactoryRpgExhaust : public LandmarkFactory {
     virtual void generate_landmarks(const std::shared_ptr<AbstractTask> &task,
-                                    Exploration &exploration) override;
+                                    const Exploration &exploration) override;
 
 public:
     explicit LandmarkFactoryRpgExhaust(const options::Options &opts);
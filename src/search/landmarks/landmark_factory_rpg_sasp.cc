@@ -411,7 +411,7 @@ void LandmarkFactoryRpgSasp::compute_disjunctive_preconditions(
 }
 
 void LandmarkFactoryRpgSasp::generate_landmarks(
-    const shared_ptr<AbstractTask> &task, Exploration &exploration) {
+    const shared_ptr<AbstractTask> &task, const Exploration &exploration) {
     TaskProxy task_proxy(*task);
     cout << "Generating landmarks using the RPG/SAS+ approach\n";
     build_dtg_successors(task_proxy);
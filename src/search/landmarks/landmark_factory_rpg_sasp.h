@@ -40,7 +40,7 @@ class LandmarkFactoryRpgSasp : public LandmarkFactory {
                               LandmarkNode *bp,
                               std::vector<std::vector<int>> &lvl_var);
     virtual void generate_landmarks(const std::shared_ptr<AbstractTask> &task,
-                                    Exploration &exploration) override;
+                                    const Exploration &exploration) override;
     void found_simple_lm_and_order(const FactPair &a, LandmarkNode &b,
                                    EdgeType t);
     void found_disj_lm_and_order(const TaskProxy &task_proxy,
@@ -21,7 +21,7 @@ LandmarkFactoryZhuGivan::LandmarkFactoryZhuGivan(const Options &opts)
 }
 
 void LandmarkFactoryZhuGivan::generate_landmarks(
-    const shared_ptr<AbstractTask> &task, Exploration &exploration) {
+    const shared_ptr<AbstractTask> &task, const Exploration &exploration) {
     TaskProxy task_proxy(*task);
     cout << "Generating landmarks using Zhu/Givan label propagation\n";
 
@@ -48,7 +48,7 @@ bool LandmarkFactoryZhuGivan::satisfies_goal_conditions(
 }
 
 void LandmarkFactoryZhuGivan::extract_landmarks(
-    const TaskProxy &task_proxy, Exploration &exploration,
+    const TaskProxy &task_proxy, const Exploration &exploration,
     const PropositionLayer &last_prop_layer) {
     utils::unused_variable(exploration);
     State initial_state = task_proxy.get_initial_state();
@@ -63,7 +63,7 @@ public:
     // Extract landmarks from last proposition layer and add them to the
     // landmarks graph
     void extract_landmarks(const TaskProxy &task_proxy,
-                           Exploration &exploration, const PropositionLayer &last_prop_layer);
+                           const Exploration &exploration, const PropositionLayer &last_prop_layer);
 
     // test if layer satisfies goal
     bool satisfies_goal_conditions(const GoalsProxy &goals, const PropositionLayer &layer) const;
@@ -72,7 +72,7 @@ public:
     void add_operator_to_triggers(const OperatorProxy &op);
 
     virtual void generate_landmarks(const std::shared_ptr<AbstractTask> &task,
-                                    Exploration &exploration) override;
+                                    const Exploration &exploration) override;
 
 public:
     explicit LandmarkFactoryZhuGivan(const options::Options &opts);
@@ -2,6 +2,8 @@
 
 #include "landmark_graph.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace landmarks {
@@ -11,7 +13,77 @@ namespace landmarks {
 */
 LandmarkStatusManager::LandmarkStatusManager(LandmarkGraph &graph)
     : reached_lms(vector<bool>(graph.number_of_landmarks(), true)),
-      lm_graph(graph) {
+      lm_graph(graph),
+      true_landmarks_state_id(StateID::no_state) {
+    build_fact_index();
+}
+
+void LandmarkStatusManager::build_fact_index() {
+    const LandmarkGraph::Nodes &nodes = lm_graph.get_nodes();
+    int num_landmarks = nodes.size();
+    vector<int> domain_sizes;
+    for (const auto &node : nodes) {
+        for (const FactPair &fact : node->facts) {
+            if (fact.var >= static_cast<int>(domain_sizes.size()))
+                domain_sizes.resize(fact.var + 1, 0);
+            domain_sizes[fact.var] = max(domain_sizes[fact.var], fact.value + 1);
+        }
+    }
+    int num_facts = 0;
+    for (size_t var = 0; var < domain_sizes.size(); ++var) {
+        if (domain_sizes[var] > 0)
+            relevant_vars.push_back(var);
+        fact_offsets.push_back(num_facts);
+        num_facts += domain_sizes[var];
+    }
+    fact_offsets.push_back(num_facts);
+
+    landmarks_by_fact.resize(num_facts);
+    num_facts_needed.resize(num_landmarks);
+    parent_ids.resize(num_landmarks);
+    for (const auto &node : nodes) {
+        int id = node->get_id();
+        for (const FactPair &fact : node->facts)
+            landmarks_by_fact[fact_offsets[fact.var] + fact.value].push_back(id);
+        num_facts_needed[id] = node->conjunctive ? node->facts.size() : 1;
+        for (const auto &parent : node->parents)
+            parent_ids[id].push_back(parent.first->get_id());
+    }
+    num_true_facts.resize(num_landmarks);
+    true_landmarks.resize(BitsetMath::compute_num_blocks(num_landmarks));
+}
+
+BitsetView LandmarkStatusManager::compute_true_landmarks(const GlobalState &state) {
+    BitsetView true_lms(
+        ArrayView<BitsetMath::Block>(true_landmarks.data(), true_landmarks.size()),
+        num_true_facts.size());
+    if (state.get_id() == true_landmarks_state_id) {
+        return true_lms;
+    }
+
+    for (int id : true_landmark_ids)
+        true_lms.reset(id);
+    true_landmark_ids.clear();
+    for (int var : relevant_vars) {
+        int value = state[var];
+        int fact_id = fact_offsets[var] + value;
+        if (fact_id >= fact_offsets[var + 1])
+            continue;
+        for (int id : landmarks_by_fact[fact_id]) {
+            if (num_true_facts[id] == 0)
+                touched_landmarks.push_back(id);
+            if (++num_true_facts[id] == num_facts_needed[id]) {
+                true_lms.set(id);
+                true_landmark_ids.push_back(id);
+            }
+        }
+    }
+    for (int id : touched_landmarks)
+        num_true_facts[id] = 0;
+    touched_landmarks.clear();
+
+    true_landmarks_state_id = state.get_id();
+    return true_lms;
 }
 
 BitsetView LandmarkStatusManager::get_reached_landmarks(const GlobalState &state) {
@@ -23,6 +95,8 @@ void LandmarkStatusManager::set_landmarks_for_initial_state(
     BitsetView reached = get_reached_landmarks(initial_state);
     // This is necessary since the default is "true for all" (see comment above).
     reached.reset();
+    // A new search starts, so the last state may have a different ID now.
+    true_landmarks_state_id = StateID::no_state;
 
     int inserted = 0;
     int num_goal_lms = 0;
@@ -72,9 +146,8 @@ bool LandmarkStatusManager::update_reached_lms(const GlobalState &parent_global_
     const BitsetView parent_reached = get_reached_landmarks(parent_global_state);
     BitsetView reached = get_reached_landmarks(global_state);
 
-    int num_landmarks = lm_graph.number_of_landmarks();
-    assert(reached.size() == num_landmarks);
-    assert(parent_reached.size() == num_landmarks);
+    assert(reached.size() == lm_graph.number_of_landmarks());
+    assert(parent_reached.size() == lm_graph.number_of_landmarks());
 
     /*
        Set all landmarks not reached by this parent as "not reached".
@@ -89,14 +162,19 @@ bool LandmarkStatusManager::update_reached_lms(const GlobalState &parent_global_
     reached.intersect(parent_reached);
 
 
-    // Mark landmarks reached right now as "reached" (if they are "leaves").
-    for (int id = 0; id < num_landmarks; ++id) {
-        if (!reached.test(id)) {
-            LandmarkNode *node = lm_graph.get_lm_for_index(id);
-            if (node->is_true_in_state(global_state)) {
-                if (landmark_is_leaf(*node, reached)) {
-                    reached.set(id);
-                }
+    /*
+      Mark landmarks reached right now as "reached" (if they are "leaves").
+      We only look at landmarks that are true in the state and skip blocks
+      of landmarks that are all false. Landmarks are processed in order of
+      their IDs since marking a landmark can turn later ones into leaves.
+    */
+    compute_true_landmarks(global_state);
+    for (size_t block_index = 0; block_index < true_landmarks.size(); ++block_index) {
+        BitsetMath::Block block = true_landmarks[block_index];
+        for (int id = block_index * BitsetMath::bits_per_block; block;
+             ++id, block >>= 1) {
+            if ((block & 1) && !reached.test(id) && landmark_is_leaf(id, reached)) {
+                reached.set(id);
             }
         }
     }
@@ -106,6 +184,7 @@ bool LandmarkStatusManager::update_reached_lms(const GlobalState &parent_global_
 
 bool LandmarkStatusManager::update_lm_status(const GlobalState &global_state) {
     const BitsetView reached = get_reached_landmarks(global_state);
+    const BitsetView true_lms = compute_true_landmarks(global_state);
 
     const LandmarkGraph::Nodes &nodes = lm_graph.get_nodes();
     // initialize all nodes to not reached and not effect of unused ALM
@@ -121,7 +200,7 @@ bool LandmarkStatusManager::update_lm_status(const GlobalState &global_state) {
     // mark reached and find needed again landmarks
     for (auto &node : nodes) {
         if (node->status == lm_reached) {
-            if (!node->is_true_in_state(global_state)) {
+            if (!true_lms.test(node->get_id())) {
                 if (node->is_goal()) {
                     node->status = lm_needed_again;
                 } else {
@@ -166,12 +245,11 @@ bool LandmarkStatusManager::check_lost_landmark_children_needed_again(const Land
     return false;
 }
 
-bool LandmarkStatusManager::landmark_is_leaf(const LandmarkNode &node, const BitsetView &reached) const {
+bool LandmarkStatusManager::landmark_is_leaf(int id, const BitsetView &reached) const {
     //Note: this is the same as !check_node_orders_disobeyed
-    for (const auto &parent : node.parents) {
-        LandmarkNode *parent_node = parent.first;
+    for (int parent_id : parent_ids[id]) {
         // Note: no condition on edge type here
-        if (!reached.test(parent_node->get_id())) {
+        if (!reached.test(parent_id)) {
             return false;
         }
     }
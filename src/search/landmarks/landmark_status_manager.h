@@ -2,6 +2,9 @@
 #define LANDMARKS_LANDMARK_STATUS_MANAGER_H
 
 #include "../per_state_bitset.h"
+#include "../state_id.h"
+
+#include <vector>
 
 namespace landmarks {
 class LandmarkGraph;
@@ -12,7 +15,40 @@ class LandmarkStatusManager {
 
     LandmarkGraph &lm_graph;
 
-    bool landmark_is_leaf(const LandmarkNode &node, const BitsetView &reached) const;
+    /*
+      Index from facts to the landmarks containing them. Only variables
+      occurring in landmarks get fact IDs: fact_offsets[var] is the ID of
+      var=0 (with one extra entry at the end) and
+      landmarks_by_fact[fact_offsets[var] + value] lists the landmark IDs
+      containing var=value. Values that occur in no landmark may lie
+      beyond the facts of their variable.
+    */
+    std::vector<int> relevant_vars;
+    std::vector<int> fact_offsets;
+    std::vector<std::vector<int>> landmarks_by_fact;
+    // Number of true facts that make a landmark true (1 unless conjunctive).
+    std::vector<int> num_facts_needed;
+    std::vector<std::vector<int>> parent_ids;
+
+    /*
+      Result of compute_true_landmarks() for the last state: the true
+      landmarks as a bitset and as a list of IDs. The heuristic
+      usually asks for the same state twice in a row (update_reached_lms
+      and update_lm_status), so we keep the result. Only the entries of
+      the previous result are reset, so the per-state cost doesn't depend
+      on the number of landmarks. State IDs are only unique within a
+      search, so set_landmarks_for_initial_state() forgets the result.
+    */
+    StateID true_landmarks_state_id;
+    std::vector<BitsetMath::Block> true_landmarks;
+    std::vector<int> true_landmark_ids;
+    // Scratch space for compute_true_landmarks(). All counters are zero between calls.
+    std::vector<int> num_true_facts;
+    std::vector<int> touched_landmarks;
+
+    void build_fact_index();
+    BitsetView compute_true_landmarks(const GlobalState &state);
+    bool landmark_is_leaf(int id, const BitsetView &reached) const;
     bool check_lost_landmark_children_needed_again(const LandmarkNode &node) const;
 public:
     explicit LandmarkStatusManager(LandmarkGraph &graph);
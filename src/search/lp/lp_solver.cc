@@ -189,6 +189,13 @@ void LPSolver::load_problem(LPObjectiveSense sense,
     clear_temporary_data();
 }
 
+void LPSolver::add_permanent_constraints(const vector<LPConstraint> &constraints) {
+    assert(!has_temporary_constraints_);
+    add_temporary_constraints(constraints);
+    num_permanent_constraints += constraints.size();
+    has_temporary_constraints_ = false;
+}
+
 void LPSolver::add_temporary_constraints(const vector<LPConstraint> &constraints) {
     if (!constraints.empty()) {
         clear_temporary_data();
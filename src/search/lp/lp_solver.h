@@ -119,6 +119,11 @@ public:
                   LPObjectiveSense sense,
                   const std::vector<LPVariable> &variables,
                   const std::vector<LPConstraint> &constraints))
+    /*
+      Add constraints that survive clear_temporary_constraints(). This is
+      only allowed while there are no temporary constraints.
+    */
+    LP_METHOD(void add_permanent_constraints(const std::vector<LPConstraint> &constraints))
     LP_METHOD(void add_temporary_constraints(const std::vector<LPConstraint> &constraints))
     LP_METHOD(void clear_temporary_constraints())
     LP_METHOD(double get_infinity() const)
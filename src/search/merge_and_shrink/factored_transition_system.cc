@@ -10,6 +10,7 @@
 #include "../utils/memory.h"
 #include "../utils/system.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -42,7 +43,8 @@ FactoredTransitionSystem::FactoredTransitionSystem(
     vector<unique_ptr<Distances>> &&distances,
     const bool compute_init_distances,
     const bool compute_goal_distances,
-    Verbosity verbosity)
+    Verbosity verbosity,
+    int num_threads)
     : labels(move(labels)),
       transition_systems(move(transition_systems)),
       mas_representations(move(mas_representations)),
@@ -50,11 +52,25 @@ FactoredTransitionSystem::FactoredTransitionSystem(
       compute_init_distances(compute_init_distances),
       compute_goal_distances(compute_goal_distances),
       num_active_entries(this->transition_systems.size()) {
-    for (size_t index = 0; index < this->transition_systems.size(); ++index) {
-        if (compute_init_distances || compute_goal_distances) {
-            this->distances[index]->compute_distances(
-                compute_init_distances, compute_goal_distances, verbosity);
+    if (compute_init_distances || compute_goal_distances) {
+        /*
+          The distances of different factors are independent. Computing them
+          in parallel would interleave the output of verbose logging, so we
+          suppress it in that case.
+        */
+        Verbosity distances_verbosity = verbosity;
+        if (num_threads > 1) {
+            distances_verbosity = min(verbosity, Verbosity::NORMAL);
         }
+        run_in_parallel(
+            this->distances.size(), num_threads,
+            [&](int index) {
+                this->distances[index]->compute_distances(
+                    compute_init_distances, compute_goal_distances,
+                    distances_verbosity);
+            });
+    }
+    for (size_t index = 0; index < this->transition_systems.size(); ++index) {
         assert(is_component_valid(index));
     }
 }
@@ -85,7 +85,8 @@ public:
         std::vector<std::unique_ptr<Distances>> &&distances,
         bool compute_init_distances,
         bool compute_goal_distances,
-        Verbosity verbosity);
+        Verbosity verbosity,
+        int num_threads);
     FactoredTransitionSystem(FactoredTransitionSystem &&other);
     ~FactoredTransitionSystem();
 
@@ -90,7 +90,8 @@ public:
     FactoredTransitionSystem create(
         bool compute_init_distances,
         bool compute_goal_distances,
-        Verbosity verbosity);
+        Verbosity verbosity,
+        int num_threads);
 };
 
 
@@ -429,7 +430,8 @@ vector<unique_ptr<Distances>> FTSFactory::create_distances(
 FactoredTransitionSystem FTSFactory::create(
     const bool compute_init_distances,
     const bool compute_goal_distances,
-    Verbosity verbosity) {
+    Verbosity verbosity,
+    int num_threads) {
     if (verbosity >= Verbosity::NORMAL) {
         cout << "Building atomic transition systems... " << endl;
     }
@@ -452,17 +454,20 @@ FactoredTransitionSystem FTSFactory::create(
         move(distances),
         compute_init_distances,
         compute_goal_distances,
-        verbosity);
+        verbosity,
+        num_threads);
 }
 
 FactoredTransitionSystem create_factored_transition_system(
     const TaskProxy &task_proxy,
     const bool compute_init_distances,
     const bool compute_goal_distances,
-    Verbosity verbosity) {
+    Verbosity verbosity,
+    int num_threads) {
     return FTSFactory(task_proxy).create(
         compute_init_distances,
         compute_goal_distances,
-        verbosity);
+        verbosity,
+        num_threads);
 }
 }
@@ -21,7 +21,8 @@ extern FactoredTransitionSystem create_factored_transition_system(
     const TaskProxy &task_proxy,
     bool compute_init_distances,
     bool compute_goal_distances,
-    Verbosity verbosity);
+    Verbosity verbosity,
+    int num_threads);
 }
 
 #endif
@@ -5,6 +5,7 @@
 #include "labels.h"
 #include "transition_system.h"
 #include "types.h"
+#include "utils.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
@@ -17,6 +18,7 @@
 #include "../utils/rng_options.h"
 #include "../utils/system.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <string>
@@ -106,7 +108,8 @@ void LabelReduction::compute_label_mapping(
 equivalence_relation::EquivalenceRelation
 *LabelReduction::compute_combinable_equivalence_relation(
     int ts_index,
-    const FactoredTransitionSystem &fts) const {
+    const FactoredTransitionSystem &fts,
+    int num_threads) const {
     /*
       Returns an equivalence relation over labels s.t. l ~ l'
       iff l and l' are locally equivalent in all transition systems
@@ -123,26 +126,55 @@ equivalence_relation::EquivalenceRelation
             annotated_labels.push_back(make_pair(0, label_no));
         }
     }
-    equivalence_relation::EquivalenceRelation *relation =
-        equivalence_relation::EquivalenceRelation::from_annotated_elements<int>(
-            num_labels, annotated_labels);
 
+    vector<int> other_indices;
     for (int index : fts) {
         if (index != ts_index) {
-            const TransitionSystem &ts = fts.get_transition_system(index);
-            for (const GroupAndTransitions &gat : ts) {
-                const LabelGroup &label_group = gat.label_group;
-                relation->refine(label_group.begin(), label_group.end());
-            }
+            other_indices.push_back(index);
         }
     }
+    int num_chunks = max(1, min(num_threads,
+                                static_cast<int>(other_indices.size())));
+
+    /*
+      Refining with the local equivalence relations of the other factors is
+      commutative, so we can split the factors into chunks, refine one
+      relation per chunk in parallel and intersect the results afterwards.
+      The resulting relation is the same, but the order of its blocks (and
+      hence the numbering of reduced labels) depends on the number of chunks.
+    */
+    vector<equivalence_relation::EquivalenceRelation *> relations(num_chunks);
+    run_in_parallel(
+        num_chunks, num_threads,
+        [&](int chunk) {
+            vector<pair<int, int>> chunk_annotated_labels(annotated_labels);
+            equivalence_relation::EquivalenceRelation *relation =
+                equivalence_relation::EquivalenceRelation::from_annotated_elements<int>(
+                    num_labels, chunk_annotated_labels);
+            for (size_t i = chunk; i < other_indices.size(); i += num_chunks) {
+                const TransitionSystem &ts =
+                    fts.get_transition_system(other_indices[i]);
+                for (const GroupAndTransitions &gat : ts) {
+                    const LabelGroup &label_group = gat.label_group;
+                    relation->refine(label_group.begin(), label_group.end());
+                }
+            }
+            relations[chunk] = relation;
+        });
+
+    equivalence_relation::EquivalenceRelation *relation = relations[0];
+    for (int chunk = 1; chunk < num_chunks; ++chunk) {
+        relation->refine(*relations[chunk]);
+        delete relations[chunk];
+    }
     return relation;
 }
 
 bool LabelReduction::reduce(
     const pair<int, int> &next_merge,
     FactoredTransitionSystem &fts,
-    Verbosity verbosity) const {
+    Verbosity verbosity,
+    int num_threads) const {
     assert(initialized());
     assert(reduce_before_shrinking() || reduce_before_merging());
     int num_transition_systems = fts.get_size();
@@ -161,7 +193,8 @@ bool LabelReduction::reduce(
 
         bool reduced = false;
         equivalence_relation::EquivalenceRelation *relation =
-            compute_combinable_equivalence_relation(next_merge.first, fts);
+            compute_combinable_equivalence_relation(
+                next_merge.first, fts, num_threads);
         vector<pair<int, vector<int>>> label_mapping;
         compute_label_mapping(relation, fts, label_mapping, verbosity);
         if (!label_mapping.empty()) {
@@ -174,7 +207,8 @@ bool LabelReduction::reduce(
 
         relation = compute_combinable_equivalence_relation(
             next_merge.second,
-            fts);
+            fts,
+            num_threads);
         compute_label_mapping(relation, fts, label_mapping, verbosity);
         if (!label_mapping.empty()) {
             fts.apply_label_mapping(label_mapping, next_merge.second);
@@ -222,7 +256,8 @@ bool LabelReduction::reduce(
         vector<pair<int, vector<int>>> label_mapping;
         if (fts.is_active(ts_index)) {
             equivalence_relation::EquivalenceRelation *relation =
-                compute_combinable_equivalence_relation(ts_index, fts);
+                compute_combinable_equivalence_relation(
+                    ts_index, fts, num_threads);
             compute_label_mapping(relation, fts, label_mapping, verbosity);
             delete relation;
         }
@@ -72,14 +72,16 @@ class LabelReduction {
     equivalence_relation::EquivalenceRelation
     *compute_combinable_equivalence_relation(
         int ts_index,
-        const FactoredTransitionSystem &fts) const;
+        const FactoredTransitionSystem &fts,
+        int num_threads) const;
 public:
     explicit LabelReduction(const options::Options &options);
     void initialize(const TaskProxy &task_proxy);
     bool reduce(
         const std::pair<int, int> &next_merge,
         FactoredTransitionSystem &fts,
-        Verbosity verbosity) const;
+        Verbosity verbosity,
+        int num_threads) const;
     void dump_options() const;
     bool reduce_before_shrinking() const {
         return lr_before_shrinking;
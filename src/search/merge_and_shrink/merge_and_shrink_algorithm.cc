@@ -52,6 +52,7 @@ MergeAndShrinkAlgorithm::MergeAndShrinkAlgorithm(const Options &opts) :
     prune_irrelevant_states(opts.get<bool>("prune_irrelevant_states")),
     verbosity(static_cast<Verbosity>(opts.get_enum("verbosity"))),
     main_loop_max_time(opts.get<double>("main_loop_max_time")),
+    num_threads(opts.get<int>("num_threads")),
     starting_peak_memory(0) {
     assert(max_states_before_merge > 0);
     assert(max_states >= max_states_before_merge);
@@ -105,6 +106,8 @@ void MergeAndShrinkAlgorithm::dump_options() const {
         break;
     }
     cout << endl;
+
+    cout << "Number of threads: " << num_threads << endl;
 }
 
 void MergeAndShrinkAlgorithm::warn_on_unusual_options() const {
@@ -210,7 +213,8 @@ void MergeAndShrinkAlgorithm::main_loop(
 
         // Label reduction (before shrinking)
         if (label_reduction && label_reduction->reduce_before_shrinking()) {
-            bool reduced = label_reduction->reduce(merge_indices, fts, verbosity);
+            bool reduced = label_reduction->reduce(
+                merge_indices, fts, verbosity, num_threads);
             if (verbosity >= Verbosity::NORMAL && reduced) {
                 log_main_loop_progress("after label reduction");
             }
@@ -229,7 +233,8 @@ void MergeAndShrinkAlgorithm::main_loop(
             max_states_before_merge,
             shrink_threshold_before_merge,
             *shrink_strategy,
-            verbosity);
+            verbosity,
+            num_threads);
         if (verbosity >= Verbosity::NORMAL && shrunk) {
             log_main_loop_progress("after shrinking");
         }
@@ -240,7 +245,8 @@ void MergeAndShrinkAlgorithm::main_loop(
 
         // Label reduction (before merging)
         if (label_reduction && label_reduction->reduce_before_merging()) {
-            bool reduced = label_reduction->reduce(merge_indices, fts, verbosity);
+            bool reduced = label_reduction->reduce(
+                merge_indices, fts, verbosity, num_threads);
             if (verbosity >= Verbosity::NORMAL && reduced) {
                 log_main_loop_progress("after label reduction");
             }
@@ -356,7 +362,8 @@ FactoredTransitionSystem MergeAndShrinkAlgorithm::build_factored_transition_syst
             task_proxy,
             compute_init_distances,
             compute_goal_distances,
-            verbosity);
+            verbosity,
+            num_threads);
     if (verbosity >= Verbosity::NORMAL) {
         log_progress(timer, "after computation of atomic factors");
     }
@@ -471,6 +478,18 @@ void add_merge_and_shrink_algorithm_options_to_parser(OptionParser &parser) {
         "transformation is runtime-intense.",
         "infinity",
         Bounds("0.0", "infinity"));
+
+    parser.add_option<int>(
+        "num_threads",
+        "Number of threads used for the per-factor computations of the "
+        "algorithm: the distances of the atomic factors, the equivalence "
+        "relations of the two factors shrunk before a merge (only for shrink "
+        "strategies that support it, currently shrink_bisimulation) and the "
+        "combinable relations of label reduction. With more than one thread, "
+        "reduced labels may be numbered differently, which can change "
+        "tie-breaking in later transformations.",
+        "1",
+        Bounds("1", "infinity"));
 }
 
 void add_transition_system_size_limit_options_to_parser(OptionParser &parser) {
@@ -44,6 +44,8 @@ class MergeAndShrinkAlgorithm {
 
     const Verbosity verbosity;
     const double main_loop_max_time;
+    // Number of threads for the per-factor computations.
+    const int num_threads;
 
     long starting_peak_memory;
 
@@ -13,6 +13,7 @@
 #include "../task_utils/task_properties.h"
 
 #include "../utils/markup.h"
+#include "../utils/memory.h"
 #include "../utils/system.h"
 
 #include <cassert>
@@ -30,6 +31,14 @@ MergeAndShrinkHeuristic::MergeAndShrinkHeuristic(const options::Options &opts)
     MergeAndShrinkAlgorithm algorithm(opts);
     FactoredTransitionSystem fts = algorithm.build_factored_transition_system(task_proxy);
     finalize(fts);
+    if (verbosity >= Verbosity::NORMAL) {
+        size_t num_bytes = 0;
+        for (const auto &mas_representation : mas_representations) {
+            num_bytes += mas_representation->estimate_memory_in_bytes();
+        }
+        cout << "Estimated memory of merge-and-shrink representations: "
+             << num_bytes / 1024 << " KB" << endl;
+    }
     cout << "Done initializing merge-and-shrink heuristic." << endl << endl;
 }
 
@@ -45,7 +54,9 @@ void MergeAndShrinkHeuristic::finalize_factor(
     }
     assert(distances->are_goal_distances_computed());
     mas_representation->set_distances(*distances);
-    mas_representations.push_back(move(mas_representation));
+    mas_representations.push_back(
+        utils::make_unique_ptr<FlatMergeAndShrinkRepresentation>(
+            *mas_representation));
 }
 
 void MergeAndShrinkHeuristic::finalize(FactoredTransitionSystem &fts) {
@@ -90,7 +101,7 @@ void MergeAndShrinkHeuristic::finalize(FactoredTransitionSystem &fts) {
 int MergeAndShrinkHeuristic::compute_heuristic(const GlobalState &global_state) {
     State state = convert_global_state(global_state);
     int heuristic = 0;
-    for (const unique_ptr<MergeAndShrinkRepresentation> &mas_representation : mas_representations) {
+    for (const unique_ptr<FlatMergeAndShrinkRepresentation> &mas_representation : mas_representations) {
         int cost = mas_representation->get_value(state);
         if (cost == PRUNED_STATE || cost == INF) {
             // If state is unreachable or irrelevant, we encountered a dead end.
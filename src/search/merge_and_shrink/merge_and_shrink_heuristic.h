@@ -7,14 +7,14 @@
 
 namespace merge_and_shrink {
 class FactoredTransitionSystem;
-class MergeAndShrinkRepresentation;
+class FlatMergeAndShrinkRepresentation;
 enum class Verbosity;
 
 class MergeAndShrinkHeuristic : public Heuristic {
     Verbosity verbosity;
 
     // The final merge-and-shrink representations, storing goal distances.
-    std::vector<std::unique_ptr<MergeAndShrinkRepresentation>> mas_representations;
+    std::vector<std::unique_ptr<FlatMergeAndShrinkRepresentation>> mas_representations;
 
     void finalize_factor(FactoredTransitionSystem &fts, int index);
     void finalize(FactoredTransitionSystem &fts);
@@ -5,9 +5,12 @@
 
 #include "../task_proxy.h"
 
+#include "../utils/system.h"
+
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <limits>
 #include <numeric>
 
 using namespace std;
@@ -60,6 +63,11 @@ int MergeAndShrinkRepresentationLeaf::get_value(const State &state) const {
     return lookup_table[value];
 }
 
+void MergeAndShrinkRepresentationLeaf::flatten(
+    FlatMergeAndShrinkRepresentation &flat) const {
+    flat.add_leaf(var_id, lookup_table);
+}
+
 void MergeAndShrinkRepresentationLeaf::dump() const {
     cout << "lookup table: ";
     for (const auto &value : lookup_table) {
@@ -76,25 +84,16 @@ MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
                                    right_child_->get_domain_size()),
       left_child(move(left_child_)),
       right_child(move(right_child_)),
-      lookup_table(left_child->get_domain_size(),
-                   vector<int>(right_child->get_domain_size())) {
-    int counter = 0;
-    for (vector<int> &row : lookup_table) {
-        for (int &entry : row) {
-            entry = counter;
-            ++counter;
-        }
-    }
+      lookup_table(domain_size) {
+    iota(lookup_table.begin(), lookup_table.end(), 0);
 }
 
 void MergeAndShrinkRepresentationMerge::set_distances(
     const Distances &distances) {
     assert(distances.are_goal_distances_computed());
-    for (vector<int> &row : lookup_table) {
-        for (int &entry : row) {
-            if (entry != PRUNED_STATE) {
-                entry = distances.get_goal_distance(entry);
-            }
+    for (int &entry : lookup_table) {
+        if (entry != PRUNED_STATE) {
+            entry = distances.get_goal_distance(entry);
         }
     }
 }
@@ -102,12 +101,10 @@ void MergeAndShrinkRepresentationMerge::set_distances(
 void MergeAndShrinkRepresentationMerge::apply_abstraction_to_lookup_table(
     const vector<int> &abstraction_mapping) {
     int new_domain_size = 0;
-    for (vector<int> &row : lookup_table) {
-        for (int &entry : row) {
-            if (entry != PRUNED_STATE) {
-                entry = abstraction_mapping[entry];
-                new_domain_size = max(new_domain_size, entry + 1);
-            }
+    for (int &entry : lookup_table) {
+        if (entry != PRUNED_STATE) {
+            entry = abstraction_mapping[entry];
+            new_domain_size = max(new_domain_size, entry + 1);
         }
     }
     domain_size = new_domain_size;
@@ -119,16 +116,24 @@ int MergeAndShrinkRepresentationMerge::get_value(
     int state2 = right_child->get_value(state);
     if (state1 == PRUNED_STATE || state2 == PRUNED_STATE)
         return PRUNED_STATE;
-    return lookup_table[state1][state2];
+    return lookup_table[state1 * right_child->get_domain_size() + state2];
+}
+
+void MergeAndShrinkRepresentationMerge::flatten(
+    FlatMergeAndShrinkRepresentation &flat) const {
+    left_child->flatten(flat);
+    right_child->flatten(flat);
+    flat.add_merge(right_child->get_domain_size(), lookup_table);
 }
 
 void MergeAndShrinkRepresentationMerge::dump() const {
     cout << "lookup table: ";
-    for (const auto &row : lookup_table) {
-        for (const auto &value : row) {
-            cout << value << ", ";
+    int num_columns = right_child->get_domain_size();
+    for (size_t i = 0; i < lookup_table.size(); ++i) {
+        cout << lookup_table[i] << ", ";
+        if ((static_cast<int>(i) + 1) % num_columns == 0) {
+            cout << endl;
         }
-        cout << endl;
     }
     cout << endl;
     cout << "dump left child:" << endl;
@@ -136,4 +141,125 @@ void MergeAndShrinkRepresentationMerge::dump() const {
     cout << "dump right child:" << endl;
     right_child->dump();
 }
+
+
+FlatMergeAndShrinkRepresentation::FlatMergeAndShrinkRepresentation(
+    const MergeAndShrinkRepresentation &representation) {
+    representation.flatten(*this);
+    tables_8.shrink_to_fit();
+    tables_16.shrink_to_fit();
+    tables_32.shrink_to_fit();
+    nodes.shrink_to_fit();
+    value_stack.reserve(nodes.size());
+}
+
+template<typename Entry>
+static void append_table(
+    const vector<int> &lookup_table, vector<Entry> &table) {
+    // The largest value of the entry type represents PRUNED_STATE.
+    const Entry pruned = numeric_limits<Entry>::max();
+    for (int entry : lookup_table) {
+        if (entry == PRUNED_STATE || entry == INF) {
+            table.push_back(pruned);
+        } else {
+            assert(entry < static_cast<int>(pruned));
+            table.push_back(static_cast<Entry>(entry));
+        }
+    }
+}
+
+void FlatMergeAndShrinkRepresentation::add_node(
+    int var_id, int num_columns, const vector<int> &lookup_table) {
+    int max_value = 0;
+    for (int entry : lookup_table) {
+        if (entry != PRUNED_STATE && entry != INF) {
+            max_value = max(max_value, entry);
+        }
+    }
+
+    Node node;
+    node.var_id = var_id;
+    node.num_columns = num_columns;
+    if (max_value < numeric_limits<uint8_t>::max()) {
+        node.width = EntryWidth::BITS_8;
+        node.table_offset = tables_8.size();
+        append_table(lookup_table, tables_8);
+    } else if (max_value < numeric_limits<uint16_t>::max()) {
+        node.width = EntryWidth::BITS_16;
+        node.table_offset = tables_16.size();
+        append_table(lookup_table, tables_16);
+    } else {
+        node.width = EntryWidth::BITS_32;
+        node.table_offset = tables_32.size();
+        append_table(lookup_table, tables_32);
+    }
+    nodes.push_back(node);
+}
+
+void FlatMergeAndShrinkRepresentation::add_leaf(
+    int var_id, const vector<int> &lookup_table) {
+    assert(var_id >= 0);
+    add_node(var_id, 0, lookup_table);
+}
+
+void FlatMergeAndShrinkRepresentation::add_merge(
+    int num_columns, const vector<int> &lookup_table) {
+    add_node(-1, num_columns, lookup_table);
+}
+
+int FlatMergeAndShrinkRepresentation::get_entry(
+    const Node &node, int index) const {
+    switch (node.width) {
+    case EntryWidth::BITS_8: {
+        uint8_t entry = tables_8[node.table_offset + index];
+        return entry == numeric_limits<uint8_t>::max() ? PRUNED_STATE : entry;
+    }
+    case EntryWidth::BITS_16: {
+        uint16_t entry = tables_16[node.table_offset + index];
+        return entry == numeric_limits<uint16_t>::max() ? PRUNED_STATE : entry;
+    }
+    case EntryWidth::BITS_32: {
+        int entry = tables_32[node.table_offset + index];
+        return entry == numeric_limits<int>::max() ? PRUNED_STATE : entry;
+    }
+    }
+    ABORT("unknown entry width");
+}
+
+int FlatMergeAndShrinkRepresentation::get_value(const State &state) const {
+    /*
+      Evaluate the nodes in post-order. Each node consumes the abstract
+      states of its children from the top of the stack. If any node maps
+      the state to PRUNED_STATE, so does the root.
+    */
+    value_stack.clear();
+    for (const Node &node : nodes) {
+        int index;
+        if (node.var_id == -1) {
+            assert(value_stack.size() >= 2);
+            int right_state = value_stack.back();
+            value_stack.pop_back();
+            int left_state = value_stack.back();
+            value_stack.pop_back();
+            index = left_state * node.num_columns + right_state;
+        } else {
+            index = state[node.var_id].get_value();
+        }
+        int value = get_entry(node, index);
+        if (value == PRUNED_STATE) {
+            return PRUNED_STATE;
+        }
+        value_stack.push_back(value);
+    }
+    assert(value_stack.size() == 1);
+    return value_stack.back();
+}
+
+size_t FlatMergeAndShrinkRepresentation::estimate_memory_in_bytes() const {
+    return nodes.capacity() * sizeof(Node) +
+           tables_8.capacity() * sizeof(uint8_t) +
+           tables_16.capacity() * sizeof(uint16_t) +
+           tables_32.capacity() * sizeof(int) +
+           value_stack.capacity() * sizeof(int);
+}
 }
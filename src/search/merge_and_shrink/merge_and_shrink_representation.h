@@ -1,6 +1,8 @@
 #ifndef MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 #define MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -8,6 +10,8 @@ class State;
 
 namespace merge_and_shrink {
 class Distances;
+class FlatMergeAndShrinkRepresentation;
+
 class MergeAndShrinkRepresentation {
 protected:
     int domain_size;
@@ -25,6 +29,8 @@ public:
     virtual int get_value(const State &state) const = 0;
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) = 0;
+    // Append the nodes of this representation to flat in post-order.
+    virtual void flatten(FlatMergeAndShrinkRepresentation &flat) const = 0;
     virtual void dump() const = 0;
 };
 
@@ -41,6 +47,7 @@ public:
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) override;
     virtual int get_value(const State &state) const override;
+    virtual void flatten(FlatMergeAndShrinkRepresentation &flat) const override;
     virtual void dump() const override;
 };
 
@@ -48,7 +55,11 @@ public:
 class MergeAndShrinkRepresentationMerge : public MergeAndShrinkRepresentation {
     std::unique_ptr<MergeAndShrinkRepresentation> left_child;
     std::unique_ptr<MergeAndShrinkRepresentation> right_child;
-    std::vector<std::vector<int>> lookup_table;
+    /*
+      Row-major table over (left state, right state); rows have the domain
+      size of right_child as length.
+    */
+    std::vector<int> lookup_table;
 public:
     MergeAndShrinkRepresentationMerge(
         std::unique_ptr<MergeAndShrinkRepresentation> left_child,
@@ -59,8 +70,63 @@ public:
     virtual void apply_abstraction_to_lookup_table(
         const std::vector<int> &abstraction_mapping) override;
     virtual int get_value(const State &state) const override;
+    virtual void flatten(FlatMergeAndShrinkRepresentation &flat) const override;
     virtual void dump() const override;
 };
+
+
+/*
+  Read-only copy of a merge-and-shrink representation that stores goal
+  distances, used for the lookups of the heuristic.
+
+  The nodes of the merge tree are stored in post-order, so get_value()
+  evaluates them iteratively with a stack of abstract states instead of
+  descending the tree recursively. The lookup tables of all nodes are
+  stored contiguously, using the smallest of 8, 16 or 32 bits per entry
+  that can hold the largest value of the node's table.
+
+  States with infinite goal distance are mapped to PRUNED_STATE, so the
+  representation cannot distinguish them from pruned states.
+*/
+class FlatMergeAndShrinkRepresentation {
+    enum class EntryWidth : char {
+        BITS_8,
+        BITS_16,
+        BITS_32
+    };
+
+    struct Node {
+        // Variable of a leaf node or -1 for merge nodes.
+        int var_id;
+        // Domain size of the right child of a merge node.
+        int num_columns;
+        EntryWidth width;
+        // Position of the node's first entry in the table of its width.
+        int table_offset;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::uint8_t> tables_8;
+    std::vector<std::uint16_t> tables_16;
+    std::vector<int> tables_32;
+
+    mutable std::vector<int> value_stack;
+
+    void add_node(int var_id, int num_columns,
+                  const std::vector<int> &lookup_table);
+    int get_entry(const Node &node, int index) const;
+public:
+    explicit FlatMergeAndShrinkRepresentation(
+        const MergeAndShrinkRepresentation &representation);
+
+    // Used by MergeAndShrinkRepresentation::flatten().
+    void add_leaf(int var_id, const std::vector<int> &lookup_table);
+    void add_merge(int num_columns, const std::vector<int> &lookup_table);
+
+    // Return the goal distance of the state or PRUNED_STATE (see above).
+    int get_value(const State &state) const;
+    std::size_t estimate_memory_in_bytes() const;
+};
 }
 
 #endif
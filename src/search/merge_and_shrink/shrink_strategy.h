@@ -39,6 +39,16 @@ public:
     virtual bool requires_init_distances() const = 0;
     virtual bool requires_goal_distances() const = 0;
 
+    /*
+      Return true iff compute_equivalence_relation may be called for
+      different transition systems concurrently. This is not the case for
+      strategies that share state (e.g. a random number generator) between
+      calls.
+    */
+    virtual bool is_thread_safe() const {
+        return false;
+    }
+
     void dump_options() const;
     std::string get_name() const;
 };
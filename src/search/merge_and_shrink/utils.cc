@@ -8,8 +8,10 @@
 #include "../utils/math.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <thread>
 
 using namespace std;
 
@@ -53,6 +55,30 @@ pair<int, int> compute_shrink_sizes(
     return make_pair(new_size1, new_size2);
 }
 
+/*
+  Return true iff the transition system violates the size limit new_size or
+  the threshold shrink_threshold_before_merge.
+*/
+static bool must_shrink(
+    const TransitionSystem &ts,
+    int new_size,
+    int shrink_threshold_before_merge,
+    Verbosity verbosity) {
+    int num_states = ts.get_size();
+    if (num_states > min(new_size, shrink_threshold_before_merge)) {
+        if (verbosity >= Verbosity::VERBOSE) {
+            cout << ts.tag() << "current size: " << num_states;
+            if (new_size < num_states)
+                cout << " (new size limit: " << new_size;
+            else
+                cout << " (shrink threshold: " << shrink_threshold_before_merge;
+            cout << ")" << endl;
+        }
+        return true;
+    }
+    return false;
+}
+
 /*
   This method checks if the transition system of the factor at index violates
   the size limit given via new_size (e.g. as computed by compute_shrink_sizes)
@@ -72,17 +98,7 @@ bool shrink_factor(
       function copy_and_shrink_ts in merge_scoring_function_miasm_utils.cc.
     */
     const TransitionSystem &ts = fts.get_transition_system(index);
-    int num_states = ts.get_size();
-    if (num_states > min(new_size, shrink_threshold_before_merge)) {
-        if (verbosity >= Verbosity::VERBOSE) {
-            cout << ts.tag() << "current size: " << num_states;
-            if (new_size < num_states)
-                cout << " (new size limit: " << new_size;
-            else
-                cout << " (shrink threshold: " << shrink_threshold_before_merge;
-            cout << ")" << endl;
-        }
-
+    if (must_shrink(ts, new_size, shrink_threshold_before_merge, verbosity)) {
         const Distances &distances = fts.get_distances(index);
         StateEquivalenceRelation equivalence_relation =
             shrink_strategy.compute_equivalence_relation(ts, distances, new_size);
@@ -93,6 +109,58 @@ bool shrink_factor(
     return false;
 }
 
+/*
+  Like calling shrink_factor for each of the given factors, but compute the
+  equivalence relations of all factors that must be shrunk in parallel.
+  Applying an abstraction only modifies the factor itself, so computing all
+  equivalence relations first yields the same abstractions.
+*/
+static bool shrink_factors_in_parallel(
+    FactoredTransitionSystem &fts,
+    const vector<int> &indices,
+    const vector<int> &new_sizes,
+    int shrink_threshold_before_merge,
+    const ShrinkStrategy &shrink_strategy,
+    Verbosity verbosity,
+    int num_threads) {
+    assert(indices.size() == new_sizes.size());
+    vector<int> shrink_indices;
+    vector<int> shrink_sizes;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (must_shrink(fts.get_transition_system(indices[i]), new_sizes[i],
+                        shrink_threshold_before_merge, verbosity)) {
+            shrink_indices.push_back(indices[i]);
+            shrink_sizes.push_back(new_sizes[i]);
+        }
+    }
+
+    int num_factors = shrink_indices.size();
+    vector<StateEquivalenceRelation> equivalence_relations(num_factors);
+    // Each task only writes to its own equivalence relation.
+    run_in_parallel(
+        num_factors, num_threads,
+        [&](int i) {
+            int index = shrink_indices[i];
+            equivalence_relations[i] =
+                shrink_strategy.compute_equivalence_relation(
+                    fts.get_transition_system(index),
+                    fts.get_distances(index),
+                    shrink_sizes[i]);
+        });
+
+    bool shrunk = false;
+    for (int i = 0; i < num_factors; ++i) {
+        int index = shrink_indices[i];
+        if (fts.apply_abstraction(index, equivalence_relations[i], verbosity)) {
+            if (verbosity >= Verbosity::VERBOSE) {
+                fts.statistics(index);
+            }
+            shrunk = true;
+        }
+    }
+    return shrunk;
+}
+
 bool shrink_before_merge_step(
     FactoredTransitionSystem &fts,
     int index1,
@@ -101,7 +169,8 @@ bool shrink_before_merge_step(
     int max_states_before_merge,
     int shrink_threshold_before_merge,
     const ShrinkStrategy &shrink_strategy,
-    Verbosity verbosity) {
+    Verbosity verbosity,
+    int num_threads) {
     /*
       Compute the size limit for both transition systems as imposed by
       max_states and max_states_before_merge.
@@ -112,6 +181,17 @@ bool shrink_before_merge_step(
         max_states_before_merge,
         max_states);
 
+    if (num_threads > 1 && shrink_strategy.is_thread_safe()) {
+        return shrink_factors_in_parallel(
+            fts,
+            {index1, index2},
+            {new_sizes.first, new_sizes.second},
+            shrink_threshold_before_merge,
+            shrink_strategy,
+            verbosity,
+            num_threads);
+    }
+
     /*
       For both transition systems, possibly compute and apply an
       abstraction.
@@ -217,4 +297,30 @@ bool is_goal_relevant(const TransitionSystem &ts) {
     }
     return false;
 }
+
+void run_in_parallel(
+    int num_tasks, int num_threads, const function<void(int)> &task) {
+    num_threads = min(num_threads, num_tasks);
+    if (num_threads <= 1) {
+        for (int i = 0; i < num_tasks; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    atomic<int> next_task(0);
+    vector<thread> threads;
+    threads.reserve(num_threads);
+    for (int thread_id = 0; thread_id < num_threads; ++thread_id) {
+        threads.emplace_back(
+            [&]() {
+                for (int i = next_task++; i < num_tasks; i = next_task++) {
+                    task(i);
+                }
+            });
+    }
+    for (thread &worker : threads) {
+        worker.join();
+    }
+}
 }
@@ -3,6 +3,7 @@
 
 #include "types.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -41,6 +42,11 @@ extern std::pair<int, int> compute_shrink_sizes(
   If shrinking is triggered, apply the abstraction to the two factors
   within the factored transition system. Return true iff at least one of the
   factors was shrunk.
+
+  If num_threads > 1, both factors must be shrunk and the shrink strategy
+  supports it, the two equivalence relations are computed in parallel. The
+  abstractions are always applied sequentially, so the result does not
+  depend on num_threads.
 */
 extern bool shrink_before_merge_step(
     FactoredTransitionSystem &fts,
@@ -50,7 +56,8 @@ extern bool shrink_before_merge_step(
     int max_states_before_merge,
     int shrink_threshold_before_merge,
     const ShrinkStrategy &shrink_strategy,
-    Verbosity verbosity);
+    Verbosity verbosity,
+    int num_threads);
 
 /*
   Prune unreachable and/or irrelevant states of the factor at index. This
@@ -75,6 +82,14 @@ extern std::vector<int> compute_abstraction_mapping(
     const StateEquivalenceRelation &equivalence_relation);
 
 extern bool is_goal_relevant(const TransitionSystem &ts);
+
+/*
+  Call task(i) for all 0 <= i < num_tasks, distributing the calls over at
+  most num_threads threads. The calls must be independent of each other.
+  With num_threads == 1, the tasks are run in order in the calling thread.
+*/
+extern void run_in_parallel(
+    int num_tasks, int num_threads, const std::function<void(int)> &task);
 }
 
 #endif
@@ -0,0 +1,323 @@
+#include "bucket_open_list.h"
+
+#include "../evaluator.h"
+#include "../open_list.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../utils/memory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+namespace bucket_open_list {
+template<class Entry>
+class FifoBucket {
+    vector<Entry> entries;
+    size_t head;
+public:
+    FifoBucket()
+        : head(0) {
+    }
+
+    bool empty() const {
+        return head == entries.size();
+    }
+
+    void push_back(const Entry &entry) {
+        entries.push_back(entry);
+    }
+
+    Entry pop_front() {
+        assert(!empty());
+        Entry result = entries[head++];
+        if (empty()) {
+            // Keep the capacity since buckets are usually refilled.
+            entries.clear();
+            head = 0;
+        } else if (head > entries.size() / 2) {
+            /* Drop the popped entries of buckets that are refilled while
+               they are emptied, e.g., on plateaus. Since at least half of
+               the entries are dropped, this takes amortized constant time. */
+            entries.erase(entries.begin(), entries.begin() + head);
+            head = 0;
+        }
+        return result;
+    }
+};
+
+
+/*
+  Maps int keys to buckets. Keys in [0, max_key] index into a vector, all
+  other keys into a map. Buckets in the vector with an index smaller than
+  lowest_candidate are empty. Buckets in the map are never empty.
+*/
+template<class Bucket>
+class BucketArray {
+    vector<Bucket> buckets;
+    map<int, Bucket> overflow;
+    int max_key;
+    Bucket empty_bucket;
+    size_t lowest_candidate;
+
+    bool is_in_array(int key) const {
+        return key >= 0 && key <= max_key;
+    }
+
+public:
+    explicit BucketArray(int max_key, const Bucket &empty_bucket = Bucket())
+        : max_key(max_key),
+          empty_bucket(empty_bucket),
+          lowest_candidate(0) {
+    }
+
+    Bucket &operator[](int key) {
+        if (is_in_array(key)) {
+            size_t index = key;
+            if (index >= buckets.size()) {
+                buckets.resize(index + 1, empty_bucket);
+            }
+            lowest_candidate = min(lowest_candidate, index);
+            return buckets[index];
+        }
+        auto it = overflow.find(key);
+        if (it == overflow.end()) {
+            it = overflow.emplace(key, empty_bucket).first;
+        }
+        return it->second;
+    }
+
+    // Return the lowest key with a non-empty bucket. There must be one.
+    int get_min_key() {
+        while (lowest_candidate < buckets.size() &&
+               buckets[lowest_candidate].empty()) {
+            ++lowest_candidate;
+        }
+        if (!overflow.empty() &&
+            (lowest_candidate == buckets.size() ||
+             overflow.begin()->first < static_cast<int>(lowest_candidate))) {
+            return overflow.begin()->first;
+        }
+        assert(lowest_candidate < buckets.size());
+        return lowest_candidate;
+    }
+
+    /*
+      Must be called when the bucket for the given key becomes empty.
+      Empty buckets in the vector stay in place and keep their memory.
+    */
+    void remove_empty_bucket(int key) {
+        if (!is_in_array(key)) {
+            assert(overflow.at(key).empty());
+            overflow.erase(key);
+        }
+    }
+
+    void clear() {
+        vector<Bucket>().swap(buckets);
+        overflow.clear();
+        lowest_candidate = 0;
+    }
+};
+
+
+template<class Entry>
+class BucketOpenList : public OpenList<Entry> {
+    struct Layer {
+        BucketArray<FifoBucket<Entry>> buckets;
+        int size;
+
+        explicit Layer(int max_key)
+            : buckets(max_key),
+              size(0) {
+        }
+
+        bool empty() const {
+            return size == 0;
+        }
+    };
+
+    BucketArray<Layer> layers;
+    int size;
+
+    vector<shared_ptr<Evaluator>> evaluators;
+    /*
+      If allow_unsafe_pruning is true, we ignore (don't insert) states
+      which the first evaluator considers a dead end, even if it is
+      not a safe heuristic.
+    */
+    bool allow_unsafe_pruning;
+
+protected:
+    virtual void do_insertion(EvaluationContext &eval_context,
+                              const Entry &entry) override;
+
+public:
+    explicit BucketOpenList(const Options &opts);
+    virtual ~BucketOpenList() override = default;
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual bool is_dead_end(
+        EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+
+template<class Entry>
+BucketOpenList<Entry>::BucketOpenList(const Options &opts)
+    : OpenList<Entry>(opts.get<bool>("pref_only")),
+      layers(opts.get<int>("max_bucket_key"),
+             Layer(opts.get<int>("max_bucket_key"))),
+      size(0),
+      evaluators(opts.get_list<shared_ptr<Evaluator>>("evals")),
+      allow_unsafe_pruning(opts.get<bool>("unsafe_pruning")) {
+    assert(evaluators.size() == 1 || evaluators.size() == 2);
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    int primary_key = eval_context.get_evaluator_value_or_infinity(
+        evaluators[0].get());
+    int secondary_key = 0;
+    if (evaluators.size() == 2) {
+        secondary_key = eval_context.get_evaluator_value_or_infinity(
+            evaluators[1].get());
+    }
+    Layer &layer = layers[primary_key];
+    layer.buckets[secondary_key].push_back(entry);
+    ++layer.size;
+    ++size;
+}
+
+template<class Entry>
+Entry BucketOpenList<Entry>::remove_min() {
+    assert(size > 0);
+    int primary_key = layers.get_min_key();
+    Layer &layer = layers[primary_key];
+    int secondary_key = layer.buckets.get_min_key();
+    FifoBucket<Entry> &bucket = layer.buckets[secondary_key];
+    Entry result = bucket.pop_front();
+    --size;
+    --layer.size;
+    if (bucket.empty()) {
+        layer.buckets.remove_empty_bucket(secondary_key);
+    }
+    if (layer.empty()) {
+        // Layers are rarely revisited, so we release their memory.
+        layer.buckets.clear();
+        layers.remove_empty_bucket(primary_key);
+    }
+    return result;
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::empty() const {
+    return size == 0;
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::clear() {
+    layers.clear();
+    size = 0;
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->get_path_dependent_evaluators(evals);
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    // Same semantics as the tiebreaking open list.
+    if (is_reliable_dead_end(eval_context))
+        return true;
+    if (allow_unsafe_pruning &&
+        eval_context.is_evaluator_value_infinite(evaluators[0].get()))
+        return true;
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        if (!eval_context.is_evaluator_value_infinite(evaluator.get()))
+            return false;
+    return true;
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        if (eval_context.is_evaluator_value_infinite(evaluator.get()) &&
+            evaluator->dead_ends_are_reliable())
+            return true;
+    return false;
+}
+
+BucketOpenListFactory::BucketOpenListFactory(const Options &options)
+    : options(options) {
+}
+
+unique_ptr<StateOpenList>
+BucketOpenListFactory::create_state_open_list() {
+    return utils::make_unique_ptr<BucketOpenList<StateOpenListEntry>>(options);
+}
+
+unique_ptr<EdgeOpenList>
+BucketOpenListFactory::create_edge_open_list() {
+    return utils::make_unique_ptr<BucketOpenList<EdgeOpenListEntry>>(options);
+}
+
+static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Bucket open list",
+        "Orders entries like the tiebreaking open list, but stores them in "
+        "an array of buckets indexed by the evaluator values. This is faster "
+        "than the tiebreaking open list if the values are small integers "
+        "that change (almost) monotonically, e.g., the f-values of A* with "
+        "a consistent heuristic.");
+    parser.document_note(
+        "Usage with A*",
+        "\n```\n--evaluator h=evaluator\n"
+        "--search eager(bucket([sum([g(), h]), h], unsafe_pruning=false),\n"
+        "               reopen_closed=true, f_eval=sum([g(), h]))\n"
+        "```\n"
+        "expands the same states in the same order as\n"
+        "```\n--search astar(evaluator)\n```\n", true);
+    parser.add_list_option<shared_ptr<Evaluator>>(
+        "evals",
+        "one or two evaluators; the second one breaks ties");
+    parser.add_option<bool>(
+        "pref_only",
+        "insert only nodes generated by preferred operators", "false");
+    parser.add_option<bool>(
+        "unsafe_pruning",
+        "allow unsafe pruning when the main evaluator regards a state a dead end",
+        "true");
+    parser.add_option<int>(
+        "max_bucket_key",
+        "evaluator values up to this bound index into an array of buckets; "
+        "larger and negative values are stored in a (slower) map",
+        "100000",
+        Bounds("0", "infinity"));
+    Options opts = parser.parse();
+    opts.verify_list_non_empty<shared_ptr<Evaluator>>("evals");
+    if (!parser.help_mode() &&
+        opts.get_list<shared_ptr<Evaluator>>("evals").size() > 2)
+        parser.error("bucket open list supports at most two evaluators");
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<BucketOpenListFactory>(opts);
+}
+
+static Plugin<OpenListFactory> _plugin("bucket", _parse);
+}
@@ -0,0 +1,35 @@
+#ifndef OPEN_LISTS_BUCKET_OPEN_LIST_H
+#define OPEN_LISTS_BUCKET_OPEN_LIST_H
+
+#include "../open_list_factory.h"
+#include "../option_parser_util.h"
+
+
+/*
+  Open list indexed by one or two ints (e.g., f and h for A*), using FIFO
+  tie-breaking. It orders entries exactly like the tiebreaking open list
+  with the same evaluators.
+
+  Instead of a map from keys to deques, keys in the range
+  [0, max_bucket_key] index directly into an array of buckets, and the
+  position of the lowest non-empty bucket is only ever moved forward
+  lazily by remove_min. If keys are (almost) monotone, as the f-values of
+  A* with a consistent heuristic are, insertion and removal take amortized
+  constant time. Keys outside of this range (in particular infinite
+  estimates) are stored in a map, so the open list stays correct for
+  arbitrary keys.
+*/
+
+namespace bucket_open_list {
+class BucketOpenListFactory : public OpenListFactory {
+    Options options;
+public:
+    explicit BucketOpenListFactory(const Options &options);
+    virtual ~BucketOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+}
+
+#endif
@@ -10,11 +10,19 @@
 #include "../utils/markup.h"
 #include "../utils/memory.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
 
 namespace operator_counting {
+LMCutConstraints::LMCutConstraints(const Options &opts)
+    : max_pooled_landmarks(opts.get<int>("max_pooled_landmarks")) {
+}
+
+LMCutConstraints::~LMCutConstraints() {
+}
+
 void LMCutConstraints::initialize_constraints(
     const shared_ptr<AbstractTask> &task, vector<lp::LPConstraint> & /*constraints*/,
     double /*infinity*/) {
@@ -28,11 +36,46 @@ bool LMCutConstraints::update_constraints(const State &state,
                                           lp::LPSolver &lp_solver) {
     assert(landmark_generator);
     vector<lp::LPConstraint> constraints;
+    vector<lp::LPConstraint> new_pooled_constraints;
     double infinity = lp_solver.get_infinity();
 
+    // Deactivate the pooled landmarks of the previous state.
+    for (int constraint_id : active_constraints) {
+        lp_solver.set_constraint_lower_bound(constraint_id, 0);
+    }
+    active_constraints.clear();
+
+    /*
+      Permanent constraints can only be added before other generators add
+      temporary constraints. Otherwise, new landmarks are temporary.
+    */
+    bool can_pool = !lp_solver.has_temporary_constraints();
+    int num_constraints = lp_solver.get_num_constraints();
+    vector<int> sorted_op_ids;
+
     bool dead_end = landmark_generator->compute_landmarks(
         state, nullptr,
         [&](const vector<int> &op_ids, int /*cost*/) {
+            if (max_pooled_landmarks > 0) {
+                sorted_op_ids = op_ids;
+                sort(sorted_op_ids.begin(), sorted_op_ids.end());
+                auto it = pooled_landmarks.find(sorted_op_ids);
+                if (it != pooled_landmarks.end()) {
+                    active_constraints.push_back(it->second);
+                    return;
+                }
+                if (can_pool &&
+                    static_cast<int>(pooled_landmarks.size()) < max_pooled_landmarks) {
+                    int constraint_id =
+                        num_constraints + new_pooled_constraints.size();
+                    pooled_landmarks.emplace(sorted_op_ids, constraint_id);
+                    new_pooled_constraints.emplace_back(1.0, infinity);
+                    for (int op_id : sorted_op_ids) {
+                        new_pooled_constraints.back().insert(op_id, 1.0);
+                    }
+                    return;
+                }
+            }
             constraints.emplace_back(1.0, infinity);
             lp::LPConstraint &landmark_constraint = constraints.back();
             for (int op_id : op_ids) {
@@ -40,12 +83,24 @@ bool LMCutConstraints::update_constraints(const State &state,
             }
         });
 
+    /*
+      Pooled constraints stay in the LP even for dead ends. Since the new
+      ones are added with the lower bound 1, they count as active.
+    */
+    if (!new_pooled_constraints.empty()) {
+        lp_solver.add_permanent_constraints(new_pooled_constraints);
+        for (size_t i = 0; i < new_pooled_constraints.size(); ++i) {
+            active_constraints.push_back(num_constraints + i);
+        }
+    }
     if (dead_end) {
         return true;
-    } else {
-        lp_solver.add_temporary_constraints(constraints);
-        return false;
     }
+    for (int constraint_id : active_constraints) {
+        lp_solver.set_constraint_lower_bound(constraint_id, 1);
+    }
+    lp_solver.add_temporary_constraints(constraints);
+    return false;
 }
 
 static shared_ptr<ConstraintGenerator> _parse(OptionParser &parser) {
@@ -75,9 +130,21 @@ static shared_ptr<ConstraintGenerator> _parse(OptionParser &parser) {
             "AAAI Press",
             "2013"));
 
+    parser.add_option<int>(
+        "max_pooled_landmarks",
+        "keep up to this many landmarks as permanent constraints of the LP. "
+        "When a pooled landmark is found again in a later state, only the "
+        "bounds of its constraint are changed, so the LP solver can start "
+        "from the previous solution instead of adding and removing rows. "
+        "Pooled landmarks of other states stay in the LP as redundant "
+        "constraints, so a large pool can also slow down the LP. "
+        "Use 0 to only use temporary constraints.",
+        "0",
+        Bounds("0", "infinity"));
+    Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
-    return make_shared<LMCutConstraints>();
+    return make_shared<LMCutConstraints>(opts);
 }
 
 static Plugin<ConstraintGenerator> _plugin("lmcut_constraints", _parse);
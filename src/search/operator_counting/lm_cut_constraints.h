@@ -3,16 +3,38 @@
 
 #include  "constraint_generator.h"
 
+#include "../utils/hash.h"
+
 #include <memory>
+#include <vector>
 
 namespace lm_cut_heuristic {
 class LandmarkCutLandmarks;
 }
 
+namespace options {
+class Options;
+}
+
 namespace operator_counting {
 class LMCutConstraints : public ConstraintGenerator {
     std::unique_ptr<lm_cut_heuristic::LandmarkCutLandmarks> landmark_generator;
+
+    /*
+      Landmarks can be kept as permanent constraints so that the LP does
+      not have to be modified structurally when they are found again.
+      pooled_landmarks maps the sorted operator IDs of a landmark to its
+      constraint. Pooled constraints have the lower bound 1 while their
+      landmark is one of the landmarks of the current state (active) and
+      the lower bound 0 otherwise.
+    */
+    const int max_pooled_landmarks;
+    utils::HashMap<std::vector<int>, int> pooled_landmarks;
+    std::vector<int> active_constraints;
 public:
+    explicit LMCutConstraints(const options::Options &opts);
+    virtual ~LMCutConstraints() override;
+
     virtual void initialize_constraints(
         const std::shared_ptr<AbstractTask> &task,
         std::vector<lp::LPConstraint> &constraints,
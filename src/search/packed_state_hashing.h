@@ -0,0 +1,101 @@
+#ifndef PACKED_STATE_HASHING_H
+#define PACKED_STATE_HASHING_H
+
+#include "packed_state_view.h"
+
+#include "utils/hash.h"
+
+#include <algorithm>
+#include <cstdint>
+
+/*
+  Hash and equality functions for packed states as used by the state
+  registries.
+
+  Most tasks fit into at most four 64-bit words (eight bins). For these
+  states we dispatch once per call on the number of bins, which is fixed for
+  a given registry, to code that is instantiated for exactly this number of
+  bins. The compiler unrolls the loops of these instantiations completely,
+  compares the states word by word and hashes each word with a single
+  64-bit mixing step instead of feeding the bins to HashState one by one.
+  Larger states use the generic code.
+
+  All registries have to use the same functions for a given state size
+  because hash values computed outside of a hash set (e.g., for prefetching)
+  must match the ones computed inside of it.
+*/
+namespace packed_state_hashing {
+using HashType = std::uint32_t;
+
+// Finalizer of MurmurHash3: changing one input bit flips each output bit
+// with a probability of about one half.
+inline std::uint64_t mix64(std::uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+template<int NumBins>
+inline HashType compute_fixed_size_hash(const PackedStateBin *data) {
+    static_assert(sizeof(PackedStateBin) == 4, "PackedStateBin does not use 4 bytes");
+    std::uint64_t hash = 0;
+    for (int i = 0; i < NumBins; i += 2) {
+        std::uint64_t word = data[i];
+        if (i + 1 < NumBins) {
+            word |= static_cast<std::uint64_t>(data[i + 1]) << 32;
+        }
+        hash = mix64(hash ^ word);
+    }
+    return static_cast<HashType>(hash);
+}
+
+template<int NumBins>
+inline bool are_fixed_size_states_equal(
+    const PackedStateBin *lhs, const PackedStateBin *rhs) {
+    for (int i = 0; i < NumBins; ++i) {
+        if (lhs[i] != rhs[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline HashType compute_hash(const PackedStateBin *data, int num_bins) {
+    switch (num_bins) {
+    case 1: return compute_fixed_size_hash<1>(data);
+    case 2: return compute_fixed_size_hash<2>(data);
+    case 3: return compute_fixed_size_hash<3>(data);
+    case 4: return compute_fixed_size_hash<4>(data);
+    case 5: return compute_fixed_size_hash<5>(data);
+    case 6: return compute_fixed_size_hash<6>(data);
+    case 7: return compute_fixed_size_hash<7>(data);
+    case 8: return compute_fixed_size_hash<8>(data);
+    default:
+        utils::HashState hash_state;
+        for (int i = 0; i < num_bins; ++i) {
+            hash_state.feed(data[i]);
+        }
+        return hash_state.get_hash32();
+    }
+}
+
+inline bool are_equal(
+    const PackedStateBin *lhs, const PackedStateBin *rhs, int num_bins) {
+    switch (num_bins) {
+    case 1: return are_fixed_size_states_equal<1>(lhs, rhs);
+    case 2: return are_fixed_size_states_equal<2>(lhs, rhs);
+    case 3: return are_fixed_size_states_equal<3>(lhs, rhs);
+    case 4: return are_fixed_size_states_equal<4>(lhs, rhs);
+    case 5: return are_fixed_size_states_equal<5>(lhs, rhs);
+    case 6: return are_fixed_size_states_equal<6>(lhs, rhs);
+    case 7: return are_fixed_size_states_equal<7>(lhs, rhs);
+    case 8: return are_fixed_size_states_equal<8>(lhs, rhs);
+    default: return std::equal(lhs, lhs + num_bins, rhs);
+    }
+}
+}
+
+#endif
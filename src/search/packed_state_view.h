@@ -0,0 +1,45 @@
+#ifndef PACKED_STATE_VIEW_H
+#define PACKED_STATE_VIEW_H
+
+#include "algorithms/int_packer.h"
+
+#include <cassert>
+
+using PackedStateBin = int_packer::IntPacker::Bin;
+
+/*
+  PackedStateView gives read access to the variable values of a state that
+  is stored in packed form, e.g., in a StateRegistry. In contrast to State,
+  creating a view neither allocates memory nor unpacks the state, so it is
+  the cheaper choice for code that only looks at a few variables of each
+  state, such as the abstraction functions of PDBs and Cartesian
+  abstractions.
+
+  A view does not own the packed data and is only valid as long as the
+  data it points to.
+*/
+class PackedStateView {
+    const PackedStateBin *buffer;
+    const int_packer::IntPacker *state_packer;
+    int num_variables;
+public:
+    PackedStateView(
+        const PackedStateBin *buffer,
+        const int_packer::IntPacker &state_packer,
+        int num_variables)
+        : buffer(buffer),
+          state_packer(&state_packer),
+          num_variables(num_variables) {
+    }
+
+    int operator[](int var) const {
+        assert(var >= 0 && var < num_variables);
+        return state_packer->get(buffer, var);
+    }
+
+    int size() const {
+        return num_variables;
+    }
+};
+
+#endif
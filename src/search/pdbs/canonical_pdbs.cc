@@ -18,20 +18,23 @@ CanonicalPDBs::CanonicalPDBs(
     assert(pattern_cliques);
 }
 
-int CanonicalPDBs::get_value(const State &state) const {
+template<typename StateType>
+static int compute_canonical_value(
+    const PDBCollection &pdbs, const vector<PatternClique> &pattern_cliques,
+    const StateType &state) {
     // If we have an empty collection, then pattern_cliques = { \emptyset }.
-    assert(!pattern_cliques->empty());
+    assert(!pattern_cliques.empty());
     int max_h = 0;
     vector<int> h_values;
-    h_values.reserve(pdbs->size());
-    for (const shared_ptr<PatternDatabase> &pdb : *pdbs) {
+    h_values.reserve(pdbs.size());
+    for (const shared_ptr<PatternDatabase> &pdb : pdbs) {
         int h = pdb->get_value(state);
         if (h == numeric_limits<int>::max()) {
             return numeric_limits<int>::max();
         }
         h_values.push_back(h);
     }
-    for (const PatternClique &clique : *pattern_cliques) {
+    for (const PatternClique &clique : pattern_cliques) {
         int clique_h = 0;
         for (PatternID pdb_index : clique) {
             clique_h += h_values[pdb_index];
@@ -40,4 +43,12 @@ int CanonicalPDBs::get_value(const State &state) const {
     }
     return max_h;
 }
+
+int CanonicalPDBs::get_value(const State &state) const {
+    return compute_canonical_value(*pdbs, *pattern_cliques, state);
+}
+
+int CanonicalPDBs::get_value(const PackedStateView &state) const {
+    return compute_canonical_value(*pdbs, *pattern_cliques, state);
+}
 }
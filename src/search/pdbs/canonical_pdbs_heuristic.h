@@ -16,11 +16,6 @@ class CanonicalPDBsHeuristic : public Heuristic {
 
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
-    /* TODO: we want to get rid of compute_heuristic(const GlobalState &state)
-       and change the interface to only use State objects. While we are doing
-       this, the following method already allows to get the heuristic value
-       for a State object. */
-    int compute_heuristic(const State &state) const;
 
 public:
     explicit CanonicalPDBsHeuristic(const options::Options &opts);
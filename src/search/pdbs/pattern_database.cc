@@ -288,10 +288,22 @@ size_t PatternDatabase::hash_index(const State &state) const {
     return index;
 }
 
+size_t PatternDatabase::hash_index(const PackedStateView &state) const {
+    size_t index = 0;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        index += hash_multipliers[i] * state[pattern[i]];
+    }
+    return index;
+}
+
 int PatternDatabase::get_value(const State &state) const {
     return distances[hash_index(state)];
 }
 
+int PatternDatabase::get_value(const PackedStateView &state) const {
+    return distances[hash_index(state)];
+}
+
 double PatternDatabase::compute_mean_finite_h() const {
     double sum = 0;
     int size = 0;
@@ -3,6 +3,7 @@
 
 #include "types.h"
 
+#include "../packed_state_view.h"
 #include "../task_proxy.h"
 
 #include <utility>
@@ -141,6 +142,7 @@ class PatternDatabase {
       (distances) during search.
     */
     std::size_t hash_index(const State &state) const;
+    std::size_t hash_index(const PackedStateView &state) const;
 public:
     /*
       Important: It is assumed that the pattern (passed via Options) is
@@ -160,6 +162,7 @@ public:
     ~PatternDatabase() = default;
 
     int get_value(const State &state) const;
+    int get_value(const PackedStateView &state) const;
 
     // Returns the pattern (i.e. all variables used) of the PDB
     const Pattern &get_pattern() const {
@@ -26,11 +26,7 @@ PDBHeuristic::PDBHeuristic(const Options &opts)
 }
 
 int PDBHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
-    return compute_heuristic(state);
-}
-
-int PDBHeuristic::compute_heuristic(const State &state) const {
+    PackedStateView state = convert_global_state_to_view(global_state);
     int h = pdb->get_value(state);
     if (h == numeric_limits<int>::max())
         return DEAD_END;
@@ -4,7 +4,6 @@
 #include "../heuristic.h"
 
 class GlobalState;
-class State;
 
 namespace options {
 class Options;
@@ -18,11 +17,6 @@ class PDBHeuristic : public Heuristic {
     std::shared_ptr<PatternDatabase> pdb;
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
-    /* TODO: we want to get rid of compute_heuristic(const GlobalState &state)
-       and change the interface to only use State objects. While we are doing
-       this, the following method already allows to get the heuristic value
-       for a State object. */
-    int compute_heuristic(const State &state) const;
 public:
     /*
       Important: It is assumed that the pattern (passed via Options) is
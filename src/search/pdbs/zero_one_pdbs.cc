@@ -39,7 +39,9 @@ ZeroOnePDBs::ZeroOnePDBs(
 }
 
 
-int ZeroOnePDBs::get_value(const State &state) const {
+template<typename StateType>
+static int compute_sum_of_values(
+    const PDBCollection &pattern_databases, const StateType &state) {
     /*
       Because we use cost partitioning, we can simply add up all
       heuristic values of all patterns in the pattern collection.
@@ -54,6 +56,14 @@ int ZeroOnePDBs::get_value(const State &state) const {
     return h_val;
 }
 
+int ZeroOnePDBs::get_value(const State &state) const {
+    return compute_sum_of_values(pattern_databases, state);
+}
+
+int ZeroOnePDBs::get_value(const PackedStateView &state) const {
+    return compute_sum_of_values(pattern_databases, state);
+}
+
 double ZeroOnePDBs::compute_approx_mean_finite_h() const {
     double approx_mean_finite_h = 0;
     for (const shared_ptr<PatternDatabase> &pdb : pattern_databases) {
@@ -3,6 +3,7 @@
 
 #include "types.h"
 
+class PackedStateView;
 class State;
 class TaskProxy;
 
@@ -14,6 +15,7 @@ public:
     ~ZeroOnePDBs() = default;
 
     int get_value(const State &state) const;
+    int get_value(const PackedStateView &state) const;
     /*
       Returns the sum of all mean finite h-values of every PDB.
       This is an approximation of the real mean finite h-value of the Heuristic,
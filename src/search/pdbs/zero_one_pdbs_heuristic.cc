@@ -27,11 +27,7 @@ ZeroOnePDBsHeuristic::ZeroOnePDBsHeuristic(
 }
 
 int ZeroOnePDBsHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
-    return compute_heuristic(state);
-}
-
-int ZeroOnePDBsHeuristic::compute_heuristic(const State &state) const {
+    PackedStateView state = convert_global_state_to_view(global_state);
     int h = zero_one_pdbs.get_value(state);
     if (h == numeric_limits<int>::max())
         return DEAD_END;
@@ -40,14 +40,25 @@ successor_generator::SuccessorGenerator &get_successor_generator(const TaskProxy
     return successor_generator;
 }
 
+static shared_ptr<mapped_segment_pool::MappedSegmentPool> create_segment_pool(
+    const Options &opts) {
+    if (opts.contains("state_storage_dir")) {
+        return make_shared<mapped_segment_pool::MappedSegmentPool>(
+            opts.get<string>("state_storage_dir"));
+    }
+    return nullptr;
+}
+
 SearchEngine::SearchEngine(const Options &opts)
     : status(IN_PROGRESS),
       solution_found(false),
       task(tasks::g_root_task),
       task_proxy(*task),
-      state_registry(task_proxy),
+      state_registry(task_proxy, create_segment_pool(opts)),
       successor_generator(get_successor_generator(task_proxy)),
-      search_space(state_registry),
+      search_space(state_registry,
+                   static_cast<OperatorCost>(opts.get_enum("cost_type")),
+                   opts.get<bool>("store_parents")),
       cost_type(static_cast<OperatorCost>(opts.get_enum("cost_type"))),
       is_unit_cost(task_properties::is_unit_cost(task_proxy)),
       max_time(opts.get<double>("max_time")) {
@@ -106,6 +117,18 @@ bool SearchEngine::check_goal_and_set_plan(const GlobalState &state) {
         cout << "Solution found!" << endl;
         Plan plan;
         search_space.trace_path(state, plan);
+        /*
+          Without parent pointers, the reconstructed plan is only guaranteed
+          to be at most as expensive as the path found in terms of adjusted
+          costs, so its real cost can exceed the bound.
+        */
+        int plan_cost = calculate_plan_cost(plan, task_proxy);
+        if (plan_cost >= bound) {
+            cout << "Reconstructed plan has cost " << plan_cost
+                 << ", which exceeds the bound. Ignoring this goal state."
+                 << endl;
+            return false;
+        }
         set_plan(plan);
         return true;
     }
@@ -151,6 +174,27 @@ void SearchEngine::add_options_to_parser(OptionParser &parser) {
         "experiments. Timed-out searches are treated as failed searches, "
         "just like incomplete search algorithms that exhaust their search space.",
         "infinity");
+    parser.add_option<string>(
+        "state_storage_dir",
+        "store the registered states and all per-state information (e.g., "
+        "search nodes) in a memory-mapped temporary file in this directory "
+        "instead of in RAM. The operating system then moves rarely used "
+        "parts of the search space to disk when memory runs low. Since "
+        "mapped memory counts toward the address space, this is only useful "
+        "if the memory limit is not imposed on the address space. "
+        "By default, everything is kept in RAM.",
+        OptionParser::NONE);
+    parser.add_option<bool>(
+        "store_parents",
+        "store the parent and creating operator of each search node. If "
+        "false, the plan is reconstructed at the end by searching backward "
+        "from the goal through the registered states, which saves 8 bytes "
+        "per state. The reconstructed plan is never more expensive than the "
+        "one found in terms of the costs given by cost_type. If cost_type is "
+        "not normal, its real cost can be higher; if it exceeds the bound, "
+        "the goal state is ignored and the search continues. "
+        "Requires positive operator costs (after applying cost_type).",
+        "true");
 }
 
 /* Method doesn't belong here because it's only useful for certain derived classes.
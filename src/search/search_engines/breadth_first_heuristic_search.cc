@@ -0,0 +1,388 @@
+#include "breadth_first_heuristic_search.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../option_parser.h"
+#include "../packed_state_hashing.h"
+#include "../plugin.h"
+
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/markup.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+#include "../utils/timer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <map>
+
+using namespace std;
+
+namespace breadth_first_heuristic_search {
+static const int INF = numeric_limits<int>::max();
+/*
+  States are evaluated in a scratch registry so that pruned states are never
+  stored in a layer. We start a new scratch registry after this many states.
+*/
+static const size_t MAX_EVALUATION_REGISTRY_SIZE = 10000;
+
+struct LayerSearchResult {
+    bool found;
+    vector<PackedStateBin> target;
+    int target_g;
+    // Empty if the path to the target did not cross the middle g-value.
+    vector<PackedStateBin> relay;
+    int relay_g;
+    // Lowest f-value of a pruned state or INF if no state was pruned.
+    int min_pruned_f;
+
+    LayerSearchResult()
+        : found(false),
+          target_g(-1),
+          relay_g(-1),
+          min_pruned_f(INF) {
+    }
+};
+
+BreadthFirstHeuristicSearch::BreadthFirstHeuristicSearch(const Options &opts)
+    : SearchEngine(opts),
+      evaluator(opts.get<shared_ptr<Evaluator>>("eval")),
+      num_closed_layers(opts.get<int>("closed_layers")),
+      f_bound(0),
+      relay_g_values(-1),
+      num_layered_searches(0),
+      peak_num_stored_states(0) {
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        if (get_adjusted_cost(op) <= 0) {
+            cerr << "Breadth-first heuristic search requires positive "
+                 << "operator costs. Use cost_type=one or cost_type=plusone."
+                 << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+        }
+    }
+}
+
+BreadthFirstHeuristicSearch::~BreadthFirstHeuristicSearch() {
+}
+
+void BreadthFirstHeuristicSearch::initialize() {
+    cout << "Conducting breadth-first heuristic search" << endl;
+    const GlobalState &initial_state = state_registry.get_initial_state();
+    state_registry.get_state_data(initial_state, initial_state_data);
+    EvaluationContext eval_context(initial_state, 0, false, &statistics);
+    statistics.inc_evaluated_states();
+    print_initial_evaluator_values(eval_context);
+    if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
+        f_bound = INF;
+    } else {
+        f_bound = eval_context.get_evaluator_value(evaluator.get());
+    }
+}
+
+bool BreadthFirstHeuristicSearch::is_same_state(
+    const PackedStateBin *lhs, const vector<PackedStateBin> &rhs) const {
+    return packed_state_hashing::are_equal(lhs, rhs.data(), rhs.size());
+}
+
+LayerSearchResult BreadthFirstHeuristicSearch::search_layers(
+    const vector<PackedStateBin> &start, int start_g,
+    const vector<PackedStateBin> *target, int f_bound, int g_bound) {
+    ++num_layered_searches;
+    LayerSearchResult result;
+    /*
+      Paths remember their last state before they cross this g-value. If the
+      crossing starts at the start state, they remember the state after it.
+    */
+    int relay_threshold = start_g + (g_bound - start_g) / 2;
+
+    map<int, unique_ptr<StateRegistry>> open_layers;
+    deque<unique_ptr<StateRegistry>> closed_layers;
+    StateRegistry relay_registry(task_proxy);
+
+    vector<OperatorID> applicable_ops;
+    vector<PackedStateBin> state_data;
+    vector<PackedStateBin> successor_data;
+
+    unique_ptr<StateRegistry> evaluation_registry;
+    auto evaluate = [&] (const vector<PackedStateBin> &data, int g) {
+            if (!evaluation_registry ||
+                evaluation_registry->size() >= MAX_EVALUATION_REGISTRY_SIZE) {
+                evaluation_registry = utils::make_unique_ptr<StateRegistry>(task_proxy);
+            }
+            GlobalState state = evaluation_registry->import_state(data.data());
+            EvaluationContext eval_context(state, g, false, &statistics);
+            statistics.inc_evaluated_states();
+            if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
+                statistics.inc_dead_ends();
+                return false;
+            }
+            int f = g + eval_context.get_evaluator_value(evaluator.get());
+            if (f > f_bound) {
+                result.min_pruned_f = min(result.min_pruned_f, f);
+                return false;
+            }
+            return true;
+        };
+
+    auto count_stored_states = [&] (const StateRegistry &current_layer) {
+            size_t num_states = current_layer.size() + relay_registry.size();
+            for (const auto &layer : open_layers) {
+                num_states += layer.second->size();
+            }
+            for (const unique_ptr<StateRegistry> &layer : closed_layers) {
+                num_states += layer->size();
+            }
+            peak_num_stored_states = max(peak_num_stored_states, num_states);
+        };
+
+    if (evaluate(start, start_g)) {
+        unique_ptr<StateRegistry> &start_layer = open_layers[start_g];
+        start_layer = utils::make_unique_ptr<StateRegistry>(task_proxy);
+        start_layer->import_state(start.data());
+    }
+
+    while (!open_layers.empty()) {
+        int g = open_layers.begin()->first;
+        unique_ptr<StateRegistry> layer = move(open_layers.begin()->second);
+        open_layers.erase(open_layers.begin());
+
+        for (StateID id : *layer) {
+            GlobalState state = layer->lookup_state(id);
+            NodeInfo info = node_infos[state];
+            if (info.status != NodeStatus::OPEN) {
+                continue;
+            }
+
+            layer->get_state_data(state, state_data);
+            bool is_target = target ?
+                is_same_state(state_data.data(), *target) :
+                task_properties::is_goal_state(task_proxy, state);
+            if (is_target) {
+                result.found = true;
+                result.target = state_data;
+                result.target_g = g;
+                if (info.relay_id != StateID::no_state) {
+                    GlobalState relay = relay_registry.lookup_state(info.relay_id);
+                    relay_registry.get_state_data(relay, result.relay);
+                    result.relay_g = relay_g_values[relay];
+                }
+                count_stored_states(*layer);
+                return result;
+            }
+
+            statistics.inc_expanded();
+            applicable_ops.clear();
+            successor_generator.generate_applicable_ops(state, applicable_ops);
+            statistics.inc_generated_ops(applicable_ops.size());
+            for (OperatorID op_id : applicable_ops) {
+                OperatorProxy op = task_proxy.get_operators()[op_id];
+                int succ_g = g + get_adjusted_cost(op);
+                if (target && succ_g > g_bound) {
+                    continue;
+                }
+                layer->compute_successor_data(state, op, successor_data);
+                statistics.inc_generated();
+
+                /*
+                  Duplicate detection: closed layers and the current layer
+                  have lower g-values, as do open layers up to succ_g. Copies
+                  in open layers with higher g-values are superseded.
+                */
+                bool is_duplicate = layer->find_state(successor_data.data()) !=
+                    StateID::no_state;
+                for (const unique_ptr<StateRegistry> &closed_layer : closed_layers) {
+                    if (is_duplicate)
+                        break;
+                    is_duplicate = closed_layer->find_state(successor_data.data()) !=
+                        StateID::no_state;
+                }
+                for (auto &open_layer : open_layers) {
+                    if (is_duplicate)
+                        break;
+                    StateID other_id = open_layer.second->find_state(successor_data.data());
+                    if (other_id != StateID::no_state) {
+                        if (open_layer.first <= succ_g) {
+                            is_duplicate = true;
+                        } else {
+                            GlobalState other = open_layer.second->lookup_state(other_id);
+                            node_infos[other].status = NodeStatus::SUPERSEDED;
+                        }
+                    }
+                }
+                if (is_duplicate || !evaluate(successor_data, succ_g)) {
+                    continue;
+                }
+
+                unique_ptr<StateRegistry> &succ_layer = open_layers[succ_g];
+                if (!succ_layer) {
+                    succ_layer = utils::make_unique_ptr<StateRegistry>(task_proxy);
+                }
+                GlobalState succ_state = succ_layer->import_state(successor_data.data());
+                NodeInfo &succ_info = node_infos[succ_state];
+                if (info.relay_id != StateID::no_state) {
+                    succ_info.relay_id = info.relay_id;
+                } else if (succ_g >= relay_threshold) {
+                    bool parent_is_start = (g == start_g);
+                    GlobalState relay = relay_registry.import_state(
+                        parent_is_start ? successor_data.data() : state_data.data());
+                    int &relay_g = relay_g_values[relay];
+                    int path_g = parent_is_start ? succ_g : g;
+                    if (relay_g == -1 || path_g < relay_g) {
+                        relay_g = path_g;
+                    }
+                    succ_info.relay_id = relay.get_id();
+                }
+            }
+        }
+
+        count_stored_states(*layer);
+        closed_layers.push_back(move(layer));
+        if (static_cast<int>(closed_layers.size()) > num_closed_layers) {
+            closed_layers.pop_front();
+        }
+    }
+    return result;
+}
+
+OperatorID BreadthFirstHeuristicSearch::find_connecting_operator(
+    const vector<PackedStateBin> &start, const vector<PackedStateBin> &target,
+    int max_cost) {
+    StateRegistry registry(task_proxy);
+    GlobalState start_state = registry.import_state(start.data());
+    vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(start_state, applicable_ops);
+    vector<PackedStateBin> successor_data;
+    OperatorID best_op = OperatorID::no_operator;
+    int best_cost = INF;
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = task_proxy.get_operators()[op_id];
+        int cost = get_adjusted_cost(op);
+        if (cost <= max_cost && cost < best_cost) {
+            registry.compute_successor_data(start_state, op, successor_data);
+            if (is_same_state(successor_data.data(), target)) {
+                best_op = op_id;
+                best_cost = cost;
+            }
+        }
+    }
+    if (best_op == OperatorID::no_operator) {
+        ABORT("Could not connect relay states.");
+    }
+    return best_op;
+}
+
+void BreadthFirstHeuristicSearch::reconstruct_path(
+    const vector<PackedStateBin> &start, int start_g,
+    const LayerSearchResult &result, int solution_cost,
+    vector<OperatorID> &path) {
+    assert(result.found);
+    if (result.relay.empty()) {
+        /*
+          The target was reached before the middle of the g-range. Now that
+          we know its g-value, the middle moves closer to the start.
+        */
+        solve_subproblem(start, start_g, result.target, result.target_g,
+                         solution_cost, path);
+    } else if (result.relay == result.target) {
+        path.push_back(find_connecting_operator(
+                           start, result.target, result.target_g - start_g));
+    } else {
+        solve_subproblem(start, start_g, result.relay, result.relay_g,
+                         solution_cost, path);
+        solve_subproblem(result.relay, result.relay_g, result.target,
+                         result.target_g, solution_cost, path);
+    }
+}
+
+void BreadthFirstHeuristicSearch::solve_subproblem(
+    const vector<PackedStateBin> &start, int start_g,
+    const vector<PackedStateBin> &target, int target_g,
+    int solution_cost, vector<OperatorID> &path) {
+    if (start == target) {
+        return;
+    }
+    LayerSearchResult result = search_layers(
+        start, start_g, &target, solution_cost, target_g);
+    if (!result.found) {
+        ABORT("Could not reconstruct the path between relay states.");
+    }
+    reconstruct_path(start, start_g, result, solution_cost, path);
+}
+
+SearchStatus BreadthFirstHeuristicSearch::step() {
+    if (f_bound == INF) {
+        cout << "Initial state is a dead end." << endl;
+        return FAILED;
+    }
+    cout << "f-bound: " << f_bound << " [t=" << utils::g_timer << "]" << endl;
+    statistics.report_f_value_progress(f_bound);
+    LayerSearchResult result = search_layers(
+        initial_state_data, 0, nullptr, f_bound, f_bound);
+    if (result.found) {
+        cout << "Solution found!" << endl;
+        Plan plan;
+        reconstruct_path(initial_state_data, 0, result, result.target_g, plan);
+        set_plan(plan);
+        return SOLVED;
+    }
+    if (result.min_pruned_f == INF) {
+        cout << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+    f_bound = result.min_pruned_f;
+    return IN_PROGRESS;
+}
+
+void BreadthFirstHeuristicSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    cout << "Layered searches: " << num_layered_searches << endl;
+    cout << "Peak number of stored states: " << peak_num_stored_states << endl;
+}
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Breadth-first heuristic search",
+        "Breadth-first iterative-deepening A* that only keeps the frontier "
+        "of the search in memory and reconstructs the plan by divide and "
+        "conquer. See" + utils::format_journal_reference(
+            {"Rong Zhou", "Eric A. Hansen"},
+            "Breadth-first heuristic search",
+            "https://doi.org/10.1016/j.artint.2005.12.002",
+            "Artificial Intelligence",
+            "170(4-5)",
+            "385-408",
+            "2006"));
+    parser.document_note(
+        "Memory",
+        "The states of each g-layer are freed once the layer is expanded and "
+        "more than closed_layers newer layers have been expanded. Larger "
+        "values avoid re-expansions in directed state spaces at the cost of "
+        "memory.");
+    parser.document_note(
+        "Supported configurations",
+        "Requires positive operator costs (after applying cost_type) and "
+        "a path-independent evaluator. The plan is optimal if the evaluator "
+        "is admissible. The bound option is not supported.");
+    parser.add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+    parser.add_option<int>(
+        "closed_layers",
+        "number of expanded layers kept for duplicate detection",
+        "2",
+        Bounds("0", "infinity"));
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    if (!parser.help_mode() && opts.get<int>("bound") != INF)
+        parser.error("breadth-first heuristic search does not support bounds");
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<BreadthFirstHeuristicSearch>(opts);
+}
+
+static Plugin<SearchEngine> _plugin("bfhs", _parse);
+}
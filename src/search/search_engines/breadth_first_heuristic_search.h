@@ -0,0 +1,107 @@
+#ifndef SEARCH_ENGINES_BREADTH_FIRST_HEURISTIC_SEARCH_H
+#define SEARCH_ENGINES_BREADTH_FIRST_HEURISTIC_SEARCH_H
+
+#include "../per_state_information.h"
+#include "../search_engine.h"
+
+#include <memory>
+#include <vector>
+
+class Evaluator;
+
+namespace options {
+class Options;
+}
+
+namespace breadth_first_heuristic_search {
+struct LayerSearchResult;
+
+/*
+  Breadth-first heuristic search with divide-and-conquer solution
+  reconstruction (Zhou and Hansen, "Breadth-first heuristic search",
+  AIJ 2006), wrapped in iterative deepening over f-bounds (BFIDA*).
+
+  Each iteration expands the states in layers of equal g-value and prunes
+  all states whose f-value exceeds the current bound before storing them.
+  Every layer has its own StateRegistry, so once a layer is expanded and no
+  longer needed for duplicate detection, its states and all per-state
+  information attached to them (including heuristic caches) are freed. Only the open layers,
+  the last few closed layers and one "relay" layer in the middle of the
+  search are kept in memory.
+
+  Instead of parent pointers, each state remembers the state on its path
+  where the path crossed the middle g-value. When a goal is found, the
+  path is reconstructed by recursively searching from the start to the
+  relay state and from the relay state to the goal. Both subsearches use
+  the same heuristic and the optimal solution cost as f-bound, which is
+  admissible for all states on an optimal path.
+
+  With an admissible heuristic, the plan is optimal. States of closed
+  layers that were already discarded may be expanded again when reached
+  on a more expensive path, which costs time but not correctness.
+*/
+class BreadthFirstHeuristicSearch : public SearchEngine {
+    enum class NodeStatus : char {
+        OPEN,
+        // Reached again with a lower g-value, the copy in the lower layer counts.
+        SUPERSEDED
+    };
+
+    struct NodeInfo {
+        // ID in the relay registry of the current layered search.
+        StateID relay_id;
+        NodeStatus status;
+
+        NodeInfo()
+            : relay_id(StateID::no_state),
+              status(NodeStatus::OPEN) {
+        }
+    };
+
+    std::shared_ptr<Evaluator> evaluator;
+    const int num_closed_layers;
+
+    std::vector<PackedStateBin> initial_state_data;
+    int f_bound;
+
+    PerStateInformation<NodeInfo> node_infos;
+    PerStateInformation<int> relay_g_values;
+
+    int num_layered_searches;
+    size_t peak_num_stored_states;
+
+    /*
+      Searches from start (whose g-value is start_g) until it expands the
+      target state or, if target is null, a goal state. States with an
+      f-value above f_bound or a g-value above g_bound are pruned.
+    */
+    LayerSearchResult search_layers(
+        const std::vector<PackedStateBin> &start, int start_g,
+        const std::vector<PackedStateBin> *target, int f_bound, int g_bound);
+    void reconstruct_path(
+        const std::vector<PackedStateBin> &start, int start_g,
+        const LayerSearchResult &result, int solution_cost,
+        std::vector<OperatorID> &path);
+    void solve_subproblem(
+        const std::vector<PackedStateBin> &start, int start_g,
+        const std::vector<PackedStateBin> &target, int target_g,
+        int solution_cost, std::vector<OperatorID> &path);
+    OperatorID find_connecting_operator(
+        const std::vector<PackedStateBin> &start,
+        const std::vector<PackedStateBin> &target, int max_cost);
+    bool is_same_state(
+        const PackedStateBin *lhs, const std::vector<PackedStateBin> &rhs) const;
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit BreadthFirstHeuristicSearch(const options::Options &opts);
+    virtual ~BreadthFirstHeuristicSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include "../algorithms/ordered_set.h"
 #include "../task_utils/successor_generator.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <memory>
@@ -122,7 +123,7 @@ SearchStatus EagerSearch::step() {
     if (check_goal_and_set_plan(s))
         return SOLVED;
 
-    vector<OperatorID> applicable_ops;
+    applicable_ops.clear();
     successor_generator.generate_applicable_ops(s, applicable_ops);
 
     /*
@@ -140,12 +141,20 @@ SearchStatus EagerSearch::step() {
                                     preferred_operators);
     }
 
-    for (OperatorID op_id : applicable_ops) {
-        OperatorProxy op = task_proxy.get_operators()[op_id];
-        if ((node.get_real_g() + op.get_cost()) >= bound)
-            continue;
-
-        GlobalState succ_state = state_registry.get_successor_state(s, op);
+    OperatorsProxy operators = task_proxy.get_operators();
+    int real_g = node.get_real_g();
+    applicable_ops.erase(
+        remove_if(applicable_ops.begin(), applicable_ops.end(),
+                  [&] (OperatorID op_id) {
+                      return real_g + operators[op_id].get_cost() >= bound;
+                  }),
+        applicable_ops.end());
+    state_registry.get_successor_states(s, applicable_ops, successor_ids);
+
+    for (size_t i = 0; i < applicable_ops.size(); ++i) {
+        OperatorID op_id = applicable_ops[i];
+        OperatorProxy op = operators[op_id];
+        GlobalState succ_state = state_registry.lookup_state(successor_ids[i]);
         statistics.inc_generated();
         bool is_preferred = preferred_operators.contains(op_id);
 
@@ -27,6 +27,10 @@ class EagerSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    // Reused in each step to avoid allocations.
+    std::vector<OperatorID> applicable_ops;
+    std::vector<StateID> successor_ids;
+
     std::pair<SearchNode, bool> fetch_next_node();
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(const SearchNode &node);
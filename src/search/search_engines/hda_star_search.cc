@@ -0,0 +1,473 @@
+#include "hda_star_search.h"
+
+#include "search_common.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../open_list_factory.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+#include "../sharded_per_state_information.h"
+#include "../sharded_state_registry.h"
+
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/countdown_timer.h"
+#include "../utils/memory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+namespace hda_star_search {
+/*
+  States are evaluated in a scratch registry because evaluators need
+  GlobalStates. We start a new scratch registry after this many states,
+  which also frees the evaluator's per-state information for the old one.
+*/
+static const size_t MAX_EVALUATION_REGISTRY_SIZE = 10000;
+
+/*
+  A state sent to its owner together with the information needed to open
+  it there and to trace the plan back to its parent.
+*/
+struct Message {
+    StateID state_id;
+    int g;
+    int real_g;
+    StateID parent_id;
+    OperatorID creating_operator;
+    Message *next;
+
+    Message(StateID state_id, int g, int real_g, StateID parent_id,
+            OperatorID creating_operator)
+        : state_id(state_id),
+          g(g),
+          real_g(real_g),
+          parent_id(parent_id),
+          creating_operator(creating_operator),
+          next(nullptr) {
+    }
+};
+
+/*
+  Lock-free multiple-producer single-consumer queue. Producers push onto
+  an intrusive stack and the consumer takes all messages at once, which
+  rules out the ABA problem. Messages are not delivered in FIFO order,
+  which does not matter for HDA*.
+*/
+class MessageQueue {
+    atomic<Message *> head;
+
+public:
+    MessageQueue()
+        : head(nullptr) {
+    }
+
+    ~MessageQueue() {
+        Message *message = pop_all();
+        while (message) {
+            Message *next = message->next;
+            delete message;
+            message = next;
+        }
+    }
+
+    void push(Message *message) {
+        message->next = head.load(memory_order_relaxed);
+        while (!head.compare_exchange_weak(
+                   message->next, message,
+                   memory_order_release, memory_order_relaxed)) {
+        }
+    }
+
+    Message *pop_all() {
+        return head.exchange(nullptr, memory_order_acquire);
+    }
+};
+
+struct NodeInfo {
+    int g;
+    int real_g;
+    int h;
+    bool closed;
+    bool dead_end;
+    StateID parent_id;
+    OperatorID creating_operator;
+
+    NodeInfo()
+        : g(-1),
+          real_g(-1),
+          h(-1),
+          closed(false),
+          dead_end(false),
+          parent_id(StateID::no_state),
+          creating_operator(OperatorID::no_operator) {
+    }
+
+    bool is_new() const {
+        return g == -1;
+    }
+};
+
+/*
+  A worker owns the shard of the search registry with its ID and is the
+  only thread that accesses the node information of the states in it.
+*/
+class Worker {
+    HDAStarSearch &engine;
+    const int id;
+    ShardedStateRegistry &state_registry;
+    ShardedPerStateInformation<NodeInfo> &node_infos;
+    shared_ptr<Evaluator> evaluator;
+    unique_ptr<StateOpenList> open_list;
+    unique_ptr<StateRegistry> evaluation_registry;
+    MessageQueue inbox;
+    SearchStatistics statistics;
+    vector<OperatorID> applicable_ops;
+    vector<PackedStateBin> successor_buffer;
+    bool active;
+
+    State unpack_state(const PackedStateBin *buffer) const {
+        int num_variables = engine.task_proxy.get_variables().size();
+        vector<int> values(num_variables);
+        for (int var = 0; var < num_variables; ++var) {
+            values[var] = state_registry.get_state_value(buffer, var);
+        }
+        return State(*engine.task, move(values));
+    }
+
+    void open_node(StateID state_id, int g, int real_g,
+                   StateID parent_id, OperatorID creating_operator) {
+        assert(state_registry.get_shard(state_id) == id);
+        NodeInfo &info = node_infos[state_id];
+        if (info.dead_end || (!info.is_new() && info.g <= g))
+            return;
+
+        bool is_new = info.is_new();
+        if (!is_new && info.closed) {
+            statistics.inc_reopened();
+        }
+        info.g = g;
+        info.real_g = real_g;
+        info.closed = false;
+        info.parent_id = parent_id;
+        info.creating_operator = creating_operator;
+
+        if (!evaluation_registry ||
+            evaluation_registry->size() >= MAX_EVALUATION_REGISTRY_SIZE) {
+            evaluation_registry =
+                utils::make_unique_ptr<StateRegistry>(engine.task_proxy);
+        }
+        GlobalState state = evaluation_registry->import_state(
+            state_registry.lookup_state_data(state_id));
+        EvaluationContext eval_context(state, g, false, &statistics);
+        if (is_new) {
+            statistics.inc_evaluated_states();
+        }
+        if (open_list->is_dead_end(eval_context)) {
+            info.dead_end = true;
+            statistics.inc_dead_ends();
+            return;
+        }
+        info.h = eval_context.get_evaluator_value(evaluator.get());
+        open_list->insert(eval_context, state_id);
+    }
+
+    void receive_messages() {
+        Message *message = inbox.pop_all();
+        if (!message)
+            return;
+        if (!active) {
+            // Become active before the messages stop counting as pending.
+            active = true;
+            ++engine.num_pending;
+        }
+        while (message) {
+            Message *next = message->next;
+            open_node(message->state_id, message->g, message->real_g,
+                      message->parent_id, message->creating_operator);
+            delete message;
+            --engine.num_pending;
+            message = next;
+        }
+    }
+
+    void expand(StateID state_id, int g, int real_g) {
+        statistics.inc_expanded();
+        // The state data never moves, even if other threads add states.
+        const PackedStateBin *buffer = state_registry.lookup_state_data(state_id);
+        State state = unpack_state(buffer);
+        if (task_properties::is_goal_state(engine.task_proxy, state)) {
+            engine.report_goal(id, state_id, g);
+            return;
+        }
+
+        applicable_ops.clear();
+        engine.successor_generator.generate_applicable_ops(state, applicable_ops);
+        statistics.inc_generated_ops(applicable_ops.size());
+
+        OperatorsProxy operators = engine.task_proxy.get_operators();
+        for (OperatorID op_id : applicable_ops) {
+            OperatorProxy op = operators[op_id];
+            if (real_g + op.get_cost() >= engine.bound)
+                continue;
+            int succ_g = g + engine.get_adjusted_cost(op);
+            if (succ_g >= engine.incumbent_cost)
+                continue;
+
+            state_registry.compute_successor_data(buffer, op, successor_buffer);
+            statistics.inc_generated();
+            /* Successors are registered by the generating thread, so the
+               owner only receives the ID of the state. */
+            StateID succ_id = state_registry.insert_state(
+                successor_buffer.data()).first;
+            int owner = state_registry.get_shard(succ_id);
+            if (owner == id) {
+                open_node(succ_id, succ_g, real_g + op.get_cost(),
+                          state_id, op_id);
+            } else {
+                ++engine.num_pending;
+                engine.workers[owner]->send(
+                    new Message(succ_id, succ_g, real_g + op.get_cost(),
+                                state_id, op_id));
+            }
+        }
+    }
+
+    /*
+      Expand the next node with an f value below the incumbent cost and
+      return false if there is no such node. Nodes that cannot lead to a
+      cheaper plan are discarded for good because the incumbent cost never
+      increases.
+    */
+    bool expand_next_node() {
+        while (!open_list->empty()) {
+            StateID state_id = open_list->remove_min();
+            NodeInfo &info = node_infos[state_id];
+            if (info.closed)
+                continue;
+            info.closed = true;
+            if (info.g + info.h >= engine.incumbent_cost)
+                continue;
+            expand(state_id, info.g, info.real_g);
+            return true;
+        }
+        return false;
+    }
+
+public:
+    Worker(HDAStarSearch &engine, int id, const shared_ptr<Evaluator> &evaluator)
+        : engine(engine),
+          id(id),
+          state_registry(*engine.search_registry),
+          node_infos(*engine.node_infos),
+          evaluator(evaluator),
+          active(true) {
+        Options opts;
+        opts.set("eval", evaluator);
+        open_list = search_common::create_astar_open_list_factory_and_f_eval(
+            opts).first->create_state_open_list();
+    }
+
+    void send(Message *message) {
+        inbox.push(message);
+    }
+
+    void run() {
+        while (!engine.abort_search) {
+            receive_messages();
+            if (expand_next_node())
+                continue;
+            if (active) {
+                active = false;
+                --engine.num_pending;
+            }
+            if (engine.num_pending == 0)
+                break;
+            this_thread::yield();
+        }
+    }
+
+    const SearchStatistics &get_statistics() const {
+        return statistics;
+    }
+};
+
+
+HDAStarSearch::HDAStarSearch(
+    const Options &opts, options::Registry &registry,
+    const options::Predefinitions &predefinitions)
+    : SearchEngine(opts),
+      eval_config(opts.get<ParseTree>("eval")),
+      registry(registry),
+      predefinitions(predefinitions),
+      num_threads(opts.get<int>("num_threads")),
+      num_pending(0),
+      abort_search(false),
+      incumbent_cost(numeric_limits<int>::max()),
+      goal_state_id(StateID::no_state) {
+    /* The axiom evaluator is shared by all registries of a task and
+       must not be used from several threads. */
+    task_properties::verify_no_axioms(task_proxy);
+    search_registry = utils::make_unique_ptr<ShardedStateRegistry>(
+        task_proxy, num_threads);
+    node_infos = utils::make_unique_ptr<ShardedPerStateInformation<NodeInfo>>(
+        *search_registry);
+}
+
+HDAStarSearch::~HDAStarSearch() {
+}
+
+void HDAStarSearch::initialize() {
+    cout << "Conducting hash-distributed A* search with " << num_threads
+         << " threads, (real) bound = " << bound << endl;
+
+    /* Heuristics are not thread-safe, so every worker needs its own
+       instance. We create them sequentially before the search starts. */
+    set<Evaluator *> evaluators;
+    for (int worker_id = 0; worker_id < num_threads; ++worker_id) {
+        OptionParser parser(eval_config, registry, predefinitions, false);
+        shared_ptr<Evaluator> evaluator =
+            parser.start_parsing<shared_ptr<Evaluator>>();
+        set<Evaluator *> path_dependent_evaluators;
+        evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
+        if (!path_dependent_evaluators.empty()) {
+            cerr << "hda_star does not support path-dependent evaluators" << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+        }
+        if (!evaluators.insert(evaluator.get()).second) {
+            cerr << "hda_star needs one evaluator per thread, so the "
+                 << "evaluator must not be predefined" << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+        workers.push_back(utils::make_unique_ptr<Worker>(*this, worker_id, evaluator));
+    }
+
+    vector<PackedStateBin> initial_buffer;
+    search_registry->compute_initial_state_data(initial_buffer);
+    StateID initial_id = search_registry->insert_state(initial_buffer.data()).first;
+    num_pending = num_threads + 1;
+    workers[search_registry->get_shard(initial_id)]->send(
+        new Message(initial_id, 0, 0, StateID::no_state,
+                    OperatorID::no_operator));
+}
+
+void HDAStarSearch::report_goal(int worker_id, StateID state_id, int g) {
+    lock_guard<mutex> lock(goal_mutex);
+    if (g < incumbent_cost) {
+        cout << "Solution with cost " << g << " found by thread "
+             << worker_id << "." << endl;
+        incumbent_cost = g;
+        goal_state_id = state_id;
+    }
+}
+
+void HDAStarSearch::extract_plan() {
+    Plan plan;
+    StateID state_id = goal_state_id;
+    while (true) {
+        const NodeInfo &info = (*node_infos)[state_id];
+        if (info.creating_operator == OperatorID::no_operator)
+            break;
+        plan.push_back(info.creating_operator);
+        state_id = info.parent_id;
+    }
+    reverse(plan.begin(), plan.end());
+    set_plan(plan);
+}
+
+SearchStatus HDAStarSearch::step() {
+    utils::CountdownTimer timer(max_time);
+    vector<thread> threads;
+    for (const unique_ptr<Worker> &worker : workers) {
+        threads.emplace_back(&Worker::run, worker.get());
+    }
+    while (num_pending > 0) {
+        if (timer.is_expired()) {
+            abort_search = true;
+            break;
+        }
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    for (thread &worker_thread : threads) {
+        worker_thread.join();
+    }
+
+    for (const unique_ptr<Worker> &worker : workers) {
+        const SearchStatistics &worker_statistics = worker->get_statistics();
+        statistics.inc_expanded(worker_statistics.get_expanded());
+        statistics.inc_evaluated_states(worker_statistics.get_evaluated_states());
+        statistics.inc_evaluations(worker_statistics.get_evaluations());
+        statistics.inc_generated(worker_statistics.get_generated());
+        statistics.inc_reopened(worker_statistics.get_reopened());
+        statistics.inc_generated_ops(worker_statistics.get_generated_ops());
+    }
+
+    if (goal_state_id == StateID::no_state) {
+        if (!abort_search) {
+            cout << "Completely explored state space -- no solution!" << endl;
+        }
+        return FAILED;
+    }
+    cout << "Solution found!" << endl;
+    extract_plan();
+    return SOLVED;
+}
+
+void HDAStarSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    search_registry->print_statistics();
+    for (size_t worker_id = 0; worker_id < workers.size(); ++worker_id) {
+        cout << "Thread " << worker_id << ": "
+             << workers[worker_id]->get_statistics().get_expanded()
+             << " expanded, "
+             << search_registry->get_shard_size(worker_id)
+             << " registered states" << endl;
+    }
+}
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Hash-distributed A* search",
+        "Parallel A* search that distributes states among threads by the "
+        "hash value of their packed data (Kishimoto, Fukunaga and Botea, "
+        "2009). Each thread uses its own instance of the evaluator. Closed "
+        "nodes are re-opened.");
+    parser.document_note(
+        "Evaluator instances",
+        "The evaluator configuration is parsed once per thread, so any "
+        "preprocessing of the heuristic is repeated for each thread. "
+        "Predefined and path-dependent evaluators are not supported.");
+    parser.document_language_support("axioms", "not supported");
+    parser.add_option<ParseTree>("eval", "evaluator for h-value");
+    parser.add_option<int>(
+        "num_threads",
+        "number of worker threads",
+        "1",
+        Bounds("1", "infinity"));
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    if (parser.help_mode()) {
+        return nullptr;
+    } else if (parser.dry_run()) {
+        // Check if the supplied evaluator can be parsed.
+        OptionParser test_parser(opts.get<ParseTree>("eval"), parser.get_registry(),
+                                 parser.get_predefinitions(), true);
+        test_parser.start_parsing<shared_ptr<Evaluator>>();
+        return nullptr;
+    } else {
+        return make_shared<HDAStarSearch>(opts, parser.get_registry(),
+                                          parser.get_predefinitions());
+    }
+}
+
+static Plugin<SearchEngine> _plugin("hda_star", _parse);
+}
@@ -0,0 +1,86 @@
+#ifndef SEARCH_ENGINES_HDA_STAR_SEARCH_H
+#define SEARCH_ENGINES_HDA_STAR_SEARCH_H
+
+#include "../option_parser_util.h"
+#include "../search_engine.h"
+
+#include "../options/registries.h"
+#include "../options/predefinitions.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ShardedStateRegistry;
+template<class Entry>
+class ShardedPerStateInformation;
+
+namespace options {
+class Options;
+}
+
+namespace hda_star_search {
+struct NodeInfo;
+class Worker;
+
+/*
+  Hash-distributed A* (Kishimoto, Fukunaga and Botea, 2009).
+
+  All workers share a sharded state registry and each worker thread owns
+  one shard, i.e., the states whose hash values select it, together with
+  their search node information. Each worker also has its own open list
+  and instance of the heuristic. Workers register generated successors
+  themselves and send the IDs of successors owned by other workers to
+  them through lock-free message queues.
+
+  The search terminates once all workers are idle and no messages are in
+  flight. Workers discard nodes with f values not below the cost of the
+  best plan found so far, so the final plan is optimal for admissible
+  heuristics.
+*/
+class HDAStarSearch : public SearchEngine {
+    friend class Worker;
+
+    const options::ParseTree eval_config;
+    /*
+      We need to copy the registry and predefinitions here since they live
+      longer than the objects referenced in the constructor.
+    */
+    options::Registry registry;
+    options::Predefinitions predefinitions;
+    const int num_threads;
+
+    std::unique_ptr<ShardedStateRegistry> search_registry;
+    std::unique_ptr<ShardedPerStateInformation<NodeInfo>> node_infos;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    /*
+      Number of active workers plus number of messages in flight. Once it
+      drops to zero, it stays zero and all workers stop.
+    */
+    std::atomic<int> num_pending;
+    std::atomic<bool> abort_search;
+    std::atomic<int> incumbent_cost;
+
+    // Protects goal_state_id.
+    std::mutex goal_mutex;
+    StateID goal_state_id;
+
+    void report_goal(int worker_id, StateID state_id, int g);
+    void extract_plan();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    HDAStarSearch(const options::Options &opts, options::Registry &registry,
+                  const options::Predefinitions &predefinitions);
+    virtual ~HDAStarSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
@@ -0,0 +1,386 @@
+#include "pipelined_astar_search.h"
+
+#include "search_common.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../evaluator_cache.h"
+#include "../open_list_factory.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <cassert>
+#include <iostream>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+namespace pipelined_astar_search {
+static const int NO_H = -1;
+
+/*
+  Evaluation threads import states into a scratch registry because
+  evaluators need GlobalStates. We start a new scratch registry after this
+  many states, which also frees the per-state information, e.g., heuristic
+  caches, that evaluators stored for the states of the old one.
+*/
+static const size_t MAX_EVALUATION_REGISTRY_SIZE = 10000;
+
+/*
+  Stands in for the evaluator in the open list of the main thread. Its
+  values are never computed but always looked up in evaluator caches that
+  hold the results of the evaluation threads.
+*/
+class PrecomputedEvaluator : public Evaluator {
+    const bool reliable_dead_ends;
+
+public:
+    PrecomputedEvaluator(const string &description, bool reliable_dead_ends)
+        : Evaluator(description, true, true, false),
+          reliable_dead_ends(reliable_dead_ends) {
+    }
+
+    virtual bool dead_ends_are_reliable() const override {
+        return reliable_dead_ends;
+    }
+
+    virtual void get_path_dependent_evaluators(set<Evaluator *> &) override {
+    }
+
+    virtual EvaluationResult compute_result(EvaluationContext &) override {
+        ABORT("Precomputed evaluator values must be looked up in the cache.");
+    }
+};
+
+class EvaluationThread {
+    PipelinedAStarSearch &engine;
+    unique_ptr<StateRegistry> evaluation_registry;
+    shared_ptr<Evaluator> evaluator;
+    SearchStatistics statistics;
+    thread worker;
+
+    void run() {
+        while (true) {
+            unique_lock<mutex> lock(engine.queue_mutex);
+            engine.requests_available.wait(lock, [this]() {
+                                               return engine.shutting_down ||
+                                               !engine.requests.empty();
+                                           });
+            if (engine.shutting_down)
+                return;
+            EvaluationRequest request = move(engine.requests.front());
+            engine.requests.pop_front();
+            lock.unlock();
+
+            if (!evaluation_registry ||
+                evaluation_registry->size() >= MAX_EVALUATION_REGISTRY_SIZE) {
+                evaluation_registry =
+                    utils::make_unique_ptr<StateRegistry>(engine.task_proxy);
+            }
+            GlobalState state = evaluation_registry->import_state(
+                request.buffer.data());
+            int old_num_evaluations = statistics.get_evaluations();
+            EvaluationContext eval_context(state, request.g, false, &statistics);
+            int h = eval_context.get_evaluator_value_or_infinity(evaluator.get());
+
+            lock.lock();
+            engine.replies.emplace_back(
+                request.state_id, h, request.parent_f,
+                statistics.get_evaluations() - old_num_evaluations);
+            lock.unlock();
+            engine.replies_available.notify_one();
+        }
+    }
+
+public:
+    EvaluationThread(PipelinedAStarSearch &engine,
+                     const shared_ptr<Evaluator> &evaluator)
+        : engine(engine),
+          evaluator(evaluator) {
+        worker = thread(&EvaluationThread::run, this);
+    }
+
+    void join() {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+
+PipelinedAStarSearch::PipelinedAStarSearch(
+    const Options &opts, options::Registry &registry,
+    const options::Predefinitions &predefinitions)
+    : SearchEngine(opts),
+      eval_config(opts.get<ParseTree>("eval")),
+      registry(registry),
+      predefinitions(predefinitions),
+      num_eval_threads(opts.get<int>("num_eval_threads")),
+      h_values(NO_H),
+      shutting_down(false) {
+}
+
+PipelinedAStarSearch::~PipelinedAStarSearch() {
+    stop_evaluation_threads();
+}
+
+void PipelinedAStarSearch::initialize() {
+    cout << "Conducting pipelined A* search with " << num_eval_threads
+         << " evaluation threads, (real) bound = " << bound << endl;
+
+    /* Heuristics are not thread-safe, so every evaluation thread needs
+       its own instance. We create them sequentially before the threads
+       start. */
+    vector<shared_ptr<Evaluator>> evaluators;
+    set<Evaluator *> unique_evaluators;
+    for (int i = 0; i < num_eval_threads; ++i) {
+        OptionParser parser(eval_config, registry, predefinitions, false);
+        shared_ptr<Evaluator> thread_evaluator =
+            parser.start_parsing<shared_ptr<Evaluator>>();
+        set<Evaluator *> path_dependent_evaluators;
+        thread_evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
+        if (!path_dependent_evaluators.empty()) {
+            cerr << "pipelined_astar does not support path-dependent evaluators"
+                 << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+        }
+        if (!unique_evaluators.insert(thread_evaluator.get()).second) {
+            cerr << "pipelined_astar needs one evaluator per thread, so the "
+                 << "evaluator must not be predefined" << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+        evaluators.push_back(thread_evaluator);
+    }
+
+    evaluator = make_shared<PrecomputedEvaluator>(
+        evaluators[0]->get_description(),
+        evaluators[0]->dead_ends_are_reliable());
+    Options opts;
+    opts.set("eval", evaluator);
+    auto open_list_factory_and_f_eval =
+        search_common::create_astar_open_list_factory_and_f_eval(opts);
+    open_list = open_list_factory_and_f_eval.first->create_state_open_list();
+    f_evaluator = open_list_factory_and_f_eval.second;
+
+    for (const shared_ptr<Evaluator> &thread_evaluator : evaluators) {
+        evaluation_threads.push_back(
+            utils::make_unique_ptr<EvaluationThread>(*this, thread_evaluator));
+    }
+
+    const GlobalState &initial_state = state_registry.get_initial_state();
+    SearchNode node = search_space.get_node(initial_state);
+    node.open_initial();
+    request_evaluation(initial_state, 0, 0);
+}
+
+void PipelinedAStarSearch::request_evaluation(
+    const GlobalState &state, int g, int parent_f) {
+    vector<PackedStateBin> buffer;
+    state_registry.get_state_data(state, buffer);
+    {
+        lock_guard<mutex> lock(queue_mutex);
+        requests.emplace_back(buffer, state.get_id(), g, parent_f);
+    }
+    requests_available.notify_one();
+    statistics.inc_evaluated_states();
+    pending_parent_f_values.insert(parent_f);
+}
+
+EvaluationContext PipelinedAStarSearch::create_eval_context(
+    const GlobalState &state, int g) {
+    assert(h_values[state] != NO_H);
+    EvaluatorCache cache(state);
+    EvaluationResult &result = cache[evaluator.get()];
+    result.set_evaluator_value(h_values[state]);
+    return EvaluationContext(cache, g, false, &statistics);
+}
+
+void PipelinedAStarSearch::insert(const GlobalState &state, int g) {
+    EvaluationContext eval_context = create_eval_context(state, g);
+    if (open_list->is_dead_end(eval_context)) {
+        search_space.get_node(state).mark_as_dead_end();
+        statistics.inc_dead_ends();
+        return;
+    }
+    open_list->insert(eval_context, state.get_id());
+    if (search_progress.check_progress(eval_context)) {
+        print_checkpoint_line(g);
+    }
+}
+
+void PipelinedAStarSearch::receive_replies(bool wait) {
+    deque<EvaluationReply> received;
+    {
+        unique_lock<mutex> lock(queue_mutex);
+        if (wait) {
+            replies_available.wait(lock, [this]() {return !replies.empty();});
+        }
+        received.swap(replies);
+    }
+
+    const GlobalState &initial_state = state_registry.get_initial_state();
+    for (const EvaluationReply &reply : received) {
+        pending_parent_f_values.erase(
+            pending_parent_f_values.find(reply.parent_f));
+        statistics.inc_evaluations(reply.num_evaluations);
+        GlobalState state = state_registry.lookup_state(reply.state_id);
+        h_values[state] = reply.h;
+        /* The node may have been reached on a cheaper path while its
+           evaluation was pending, so we use its current g value. */
+        int g = search_space.get_node(state).get_g();
+        if (reply.state_id == initial_state.get_id()) {
+            EvaluationContext eval_context = create_eval_context(state, g);
+            print_initial_evaluator_values(eval_context);
+            statistics.report_f_value_progress(
+                eval_context.get_evaluator_value_or_infinity(f_evaluator.get()));
+        }
+        insert(state, g);
+    }
+}
+
+void PipelinedAStarSearch::stop_evaluation_threads() {
+    {
+        lock_guard<mutex> lock(queue_mutex);
+        shutting_down = true;
+    }
+    requests_available.notify_all();
+    for (const unique_ptr<EvaluationThread> &evaluation_thread : evaluation_threads) {
+        evaluation_thread->join();
+    }
+}
+
+void PipelinedAStarSearch::print_checkpoint_line(int g) const {
+    cout << "[g=" << g << ", ";
+    statistics.print_basic_statistics();
+    cout << "]" << endl;
+}
+
+void PipelinedAStarSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    search_space.print_statistics();
+}
+
+SearchStatus PipelinedAStarSearch::step() {
+    receive_replies(false);
+    if (open_list->empty()) {
+        if (pending_parent_f_values.empty()) {
+            cout << "Completely explored state space -- no solution!" << endl;
+            stop_evaluation_threads();
+            return FAILED;
+        }
+        receive_replies(true);
+        return IN_PROGRESS;
+    }
+
+    StateID id = open_list->remove_min();
+    GlobalState s = state_registry.lookup_state(id);
+    SearchNode node = search_space.get_node(s);
+    if (node.is_closed() || node.is_dead_end())
+        return IN_PROGRESS;
+
+    EvaluationContext eval_context = create_eval_context(s, node.get_g());
+    int f = eval_context.get_evaluator_value(f_evaluator.get());
+    bool is_goal = task_properties::is_goal_state(task_proxy, s);
+    if (!pending_parent_f_values.empty() &&
+        (is_goal || f > *pending_parent_f_values.begin())) {
+        /* States under evaluation might have lower f values. Goal
+           states additionally wait for all pending states because
+           they might lead to cheaper plans. */
+        do {
+            receive_replies(true);
+        } while (is_goal && !pending_parent_f_values.empty());
+        insert(s, node.get_g());
+        return IN_PROGRESS;
+    }
+
+    if (is_goal) {
+        check_goal_and_set_plan(s);
+        stop_evaluation_threads();
+        return SOLVED;
+    }
+
+    node.close();
+    statistics.inc_expanded();
+    statistics.report_f_value_progress(f);
+
+    vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(s, applicable_ops);
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = task_proxy.get_operators()[op_id];
+        if ((node.get_real_g() + op.get_cost()) >= bound)
+            continue;
+
+        GlobalState succ_state = state_registry.get_successor_state(s, op);
+        statistics.inc_generated();
+        SearchNode succ_node = search_space.get_node(succ_state);
+
+        // Previously encountered dead end. Don't re-evaluate.
+        if (succ_node.is_dead_end())
+            continue;
+
+        int succ_g = node.get_g() + get_adjusted_cost(op);
+        if (succ_node.is_new()) {
+            succ_node.open(node, op, get_adjusted_cost(op));
+            request_evaluation(succ_state, succ_g, f);
+        } else if (succ_node.get_g() > succ_g) {
+            // We found a new cheapest path to an open or closed state.
+            if (succ_node.is_closed()) {
+                statistics.inc_reopened();
+                succ_node.reopen(node, op, get_adjusted_cost(op));
+            } else {
+                succ_node.update_parent(node, op, get_adjusted_cost(op));
+            }
+            /* Pending states enter the open list with their current g
+               value once their evaluation arrives. */
+            if (h_values[succ_state] != NO_H) {
+                insert(succ_state, succ_node.get_g());
+            }
+        }
+    }
+
+    return IN_PROGRESS;
+}
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Pipelined A* search",
+        "A* search that evaluates states on separate threads while the "
+        "main thread continues expanding evaluated nodes. Each evaluation "
+        "thread uses its own instance of the evaluator. Closed nodes are "
+        "re-opened.");
+    parser.document_note(
+        "Evaluator instances",
+        "The evaluator configuration is parsed once per evaluation thread, "
+        "so any preprocessing of the heuristic is repeated for each thread. "
+        "Predefined and path-dependent evaluators are not supported.");
+    parser.add_option<ParseTree>("eval", "evaluator for h-value");
+    parser.add_option<int>(
+        "num_eval_threads",
+        "number of threads that evaluate states",
+        "1",
+        Bounds("1", "infinity"));
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    if (parser.help_mode()) {
+        return nullptr;
+    } else if (parser.dry_run()) {
+        // Check if the supplied evaluator can be parsed.
+        OptionParser test_parser(opts.get<ParseTree>("eval"), parser.get_registry(),
+                                 parser.get_predefinitions(), true);
+        test_parser.start_parsing<shared_ptr<Evaluator>>();
+        return nullptr;
+    } else {
+        return make_shared<PipelinedAStarSearch>(
+            opts, parser.get_registry(), parser.get_predefinitions());
+    }
+}
+
+static Plugin<SearchEngine> _plugin("pipelined_astar", _parse);
+}
@@ -0,0 +1,120 @@
+#ifndef SEARCH_ENGINES_PIPELINED_ASTAR_SEARCH_H
+#define SEARCH_ENGINES_PIPELINED_ASTAR_SEARCH_H
+
+#include "../open_list.h"
+#include "../option_parser_util.h"
+#include "../search_engine.h"
+
+#include "../options/registries.h"
+#include "../options/predefinitions.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+class EvaluationContext;
+class Evaluator;
+
+namespace options {
+class Options;
+}
+
+namespace pipelined_astar_search {
+class EvaluationThread;
+
+struct EvaluationRequest {
+    std::vector<PackedStateBin> buffer;
+    StateID state_id;
+    int g;
+    int parent_f;
+
+    EvaluationRequest(const std::vector<PackedStateBin> &buffer,
+                      StateID state_id, int g, int parent_f)
+        : buffer(buffer), state_id(state_id), g(g), parent_f(parent_f) {
+    }
+};
+
+struct EvaluationReply {
+    StateID state_id;
+    int h;
+    int parent_f;
+    int num_evaluations;
+
+    EvaluationReply(StateID state_id, int h, int parent_f, int num_evaluations)
+        : state_id(state_id), h(h), parent_f(parent_f),
+          num_evaluations(num_evaluations) {
+    }
+};
+
+/*
+  A* search that moves heuristic evaluation to a pool of threads.
+
+  The main thread expands nodes and generates successors while the
+  evaluation threads compute h values for newly generated states. Only
+  evaluated states enter the open list.
+
+  To avoid expanding nodes that A* would never expand, the main thread
+  only expands a node if its f value does not exceed the f value of the
+  parent of any pending state. For consistent heuristics, pending states
+  cannot have lower f values than their parents, so nodes are expanded
+  in the usual order. For other heuristics, closed nodes are reopened
+  when cheaper paths to them are found. A goal state is only accepted once no evaluations are
+  pending and it is still a minimum of the open list, which keeps A*
+  optimal for admissible heuristics.
+*/
+class PipelinedAStarSearch : public SearchEngine {
+    friend class EvaluationThread;
+
+    const options::ParseTree eval_config;
+    /*
+      We need to copy the registry and predefinitions here since they live
+      longer than the objects referenced in the constructor.
+    */
+    options::Registry registry;
+    options::Predefinitions predefinitions;
+    const int num_eval_threads;
+
+    /*
+      The open list of the main thread uses a placeholder for the
+      evaluator and looks up all its values from the replies.
+    */
+    std::shared_ptr<Evaluator> evaluator;
+    std::shared_ptr<Evaluator> f_evaluator;
+    std::unique_ptr<StateOpenList> open_list;
+    PerStateInformation<int> h_values;
+    // f values of the parents of all states under evaluation.
+    std::multiset<int> pending_parent_f_values;
+
+    std::vector<std::unique_ptr<EvaluationThread>> evaluation_threads;
+    std::mutex queue_mutex;
+    std::condition_variable requests_available;
+    std::condition_variable replies_available;
+    std::deque<EvaluationRequest> requests;
+    std::deque<EvaluationReply> replies;
+    bool shutting_down;
+
+    void request_evaluation(const GlobalState &state, int g, int parent_f);
+    EvaluationContext create_eval_context(const GlobalState &state, int g);
+    void receive_replies(bool wait);
+    void insert(const GlobalState &state, int g);
+    void stop_evaluation_threads();
+    void print_checkpoint_line(int g) const;
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    PipelinedAStarSearch(
+        const options::Options &opts, options::Registry &registry,
+        const options::Predefinitions &predefinitions);
+    virtual ~PipelinedAStarSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
@@ -7,18 +7,31 @@
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
+/*
+  The search space stores the fields every search node needs (status and g)
+  separately from the fields that only some searches need (parent pointers
+  and real g-values), so the latter only use memory if they are used.
+*/
 struct SearchNodeInfo {
     enum NodeStatus {NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3};
 
+    // Largest g-value that fits into the g field.
+    static const int MAX_G = (1 << 29) - 1;
+
     unsigned int status : 2;
     int g : 30;
+
+    SearchNodeInfo()
+        : status(NEW), g(-1) {
+    }
+};
+
+struct SearchNodeParent {
     StateID parent_state_id;
     OperatorID creating_operator;
-    int real_g;
 
-    SearchNodeInfo()
-        : status(NEW), g(-1), parent_state_id(StateID::no_state),
-          creating_operator(-1), real_g(-1) {
+    SearchNodeParent()
+        : parent_state_id(StateID::no_state), creating_operator(-1) {
     }
 };
 
@@ -4,21 +4,25 @@
 #include "search_node_info.h"
 #include "task_proxy.h"
 
+#include "task_utils/task_properties.h"
+#include "utils/system.h"
+
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
 
-SearchNode::SearchNode(const StateRegistry &state_registry,
+SearchNode::SearchNode(SearchSpace &search_space,
                        StateID state_id,
                        SearchNodeInfo &info)
-    : state_registry(state_registry),
+    : search_space(search_space),
       state_id(state_id),
       info(info) {
     assert(state_id != StateID::no_state);
 }
 
 GlobalState SearchNode::get_state() const {
-    return state_registry.lookup_state(state_id);
+    return search_space.state_registry.lookup_state(state_id);
 }
 
 bool SearchNode::is_open() const {
@@ -43,16 +47,50 @@ int SearchNode::get_g() const {
 }
 
 int SearchNode::get_real_g() const {
-    return info.real_g;
+    if (search_space.store_real_g) {
+        return search_space.real_g_values[get_state()];
+    }
+    return info.g;
+}
+
+void SearchNode::set_parent(const SearchNode &parent_node,
+                            const OperatorProxy &parent_op,
+                            int adjusted_cost) {
+    if (adjusted_cost > SearchNodeInfo::MAX_G - parent_node.info.g) {
+        cerr << "g-value exceeds the maximum supported g-value "
+             << SearchNodeInfo::MAX_G << "." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+    info.g = parent_node.info.g + adjusted_cost;
+    if (search_space.store_real_g || search_space.store_parents) {
+        GlobalState state = get_state();
+        if (search_space.store_real_g) {
+            search_space.real_g_values[state] =
+                parent_node.get_real_g() + parent_op.get_cost();
+        }
+        if (search_space.store_parents) {
+            SearchNodeParent &parent = search_space.search_node_parents[state];
+            parent.parent_state_id = parent_node.get_state_id();
+            parent.creating_operator = OperatorID(parent_op.get_id());
+        }
+    }
 }
 
 void SearchNode::open_initial() {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
     info.g = 0;
-    info.real_g = 0;
-    info.parent_state_id = StateID::no_state;
-    info.creating_operator = OperatorID::no_operator;
+    if (search_space.store_real_g || search_space.store_parents) {
+        GlobalState state = get_state();
+        if (search_space.store_real_g) {
+            search_space.real_g_values[state] = 0;
+        }
+        if (search_space.store_parents) {
+            SearchNodeParent &parent = search_space.search_node_parents[state];
+            parent.parent_state_id = StateID::no_state;
+            parent.creating_operator = OperatorID::no_operator;
+        }
+    }
 }
 
 void SearchNode::open(const SearchNode &parent_node,
@@ -60,10 +98,7 @@ void SearchNode::open(const SearchNode &parent_node,
                       int adjusted_cost) {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::reopen(const SearchNode &parent_node,
@@ -75,10 +110,7 @@ void SearchNode::reopen(const SearchNode &parent_node,
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
     info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_parent(parent_node, parent_op, adjusted_cost);
 }
 
 // like reopen, except doesn't change status
@@ -89,10 +121,7 @@ void SearchNode::update_parent(const SearchNode &parent_node,
            info.status == SearchNodeInfo::CLOSED);
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::close() {
@@ -106,37 +135,259 @@ void SearchNode::mark_as_dead_end() {
 
 void SearchNode::dump(const TaskProxy &task_proxy) const {
     cout << state_id << ": ";
-    get_state().dump_fdr();
-    if (info.creating_operator != OperatorID::no_operator) {
+    GlobalState state = get_state();
+    state.dump_fdr();
+    if (!search_space.store_parents) {
+        cout << " parent not stored" << endl;
+        return;
+    }
+    const SearchNodeParent &parent = search_space.search_node_parents[state];
+    if (parent.creating_operator != OperatorID::no_operator) {
         OperatorsProxy operators = task_proxy.get_operators();
-        OperatorProxy op = operators[info.creating_operator.get_index()];
+        OperatorProxy op = operators[parent.creating_operator.get_index()];
         cout << " created by " << op.get_name()
-             << " from " << info.parent_state_id << endl;
+             << " from " << parent.parent_state_id << endl;
     } else {
         cout << " no parent" << endl;
     }
 }
 
-SearchSpace::SearchSpace(StateRegistry &state_registry)
-    : state_registry(state_registry) {
+/*
+  Real g-values only have to be stored if the search uses adjusted costs
+  that differ from the real costs for some operator.
+*/
+static bool g_can_differ_from_real_g(OperatorCost cost_type, bool is_unit_cost) {
+    return cost_type != NORMAL && !is_unit_cost;
+}
+
+SearchSpace::SearchSpace(
+    StateRegistry &state_registry, OperatorCost cost_type, bool store_parents)
+    : real_g_values(-1),
+      state_registry(state_registry),
+      cost_type(cost_type),
+      is_unit_cost(task_properties::is_unit_cost(state_registry.get_task_proxy())),
+      store_parents(store_parents),
+      store_real_g(g_can_differ_from_real_g(cost_type, is_unit_cost)) {
+    if (!store_parents) {
+        for (OperatorProxy op : state_registry.get_task_proxy().get_operators()) {
+            if (get_adjusted_action_cost(op, cost_type, is_unit_cost) <= 0) {
+                cerr << "Reconstructing plans without parent pointers "
+                     << "requires positive operator costs. Use "
+                     << "cost_type=one or cost_type=plusone." << endl;
+                utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+            }
+        }
+    }
 }
 
 SearchNode SearchSpace::get_node(const GlobalState &state) {
-    return SearchNode(state_registry, state.get_id(), search_node_infos[state]);
+    return SearchNode(*this, state.get_id(), search_node_infos[state]);
 }
 
 void SearchSpace::trace_path(const GlobalState &goal_state,
                              vector<OperatorID> &path) const {
-    GlobalState current_state = goal_state;
     assert(path.empty());
+    if (!store_parents) {
+        trace_path_by_regression(goal_state, path);
+        return;
+    }
+    GlobalState current_state = goal_state;
     for (;;) {
-        const SearchNodeInfo &info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
+        const SearchNodeParent &parent = search_node_parents[current_state];
+        if (parent.creating_operator == OperatorID::no_operator) {
+            assert(parent.parent_state_id == StateID::no_state);
             break;
         }
-        path.push_back(info.creating_operator);
-        current_state = state_registry.lookup_state(info.parent_state_id);
+        path.push_back(parent.creating_operator);
+        current_state = state_registry.lookup_state(parent.parent_state_id);
+    }
+    reverse(path.begin(), path.end());
+}
+
+static bool is_applicable(const OperatorProxy &op, const GlobalState &state) {
+    for (FactProxy precondition : op.get_preconditions()) {
+        if (state[precondition.get_variable().get_id()] != precondition.get_value()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool leads_to(const GlobalState &state, const OperatorProxy &op,
+                     const GlobalState &successor, const VariablesProxy &variables,
+                     vector<int> &successor_values) {
+    successor_values.resize(variables.size());
+    for (size_t var = 0; var < successor_values.size(); ++var) {
+        successor_values[var] = state[var];
+    }
+    for (EffectProxy effect : op.get_effects()) {
+        bool fires = true;
+        for (FactProxy condition : effect.get_conditions()) {
+            if (state[condition.get_variable().get_id()] != condition.get_value()) {
+                fires = false;
+                break;
+            }
+        }
+        if (fires) {
+            FactPair fact = effect.get_fact().get_pair();
+            successor_values[fact.var] = fact.value;
+        }
+    }
+    // Derived variables only depend on the other variables.
+    for (VariableProxy var : variables) {
+        if (!var.is_derived() &&
+            successor_values[var.get_id()] != successor[var.get_id()]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Operators whose unconditional effects all hold in the given state.
+static void compute_regressable_operators(
+    const OperatorsProxy &operators, const GlobalState &state,
+    vector<OperatorID> &result) {
+    result.clear();
+    for (OperatorProxy op : operators) {
+        bool regressable = true;
+        for (EffectProxy effect : op.get_effects()) {
+            FactPair fact = effect.get_fact().get_pair();
+            if (effect.get_conditions().empty() && state[fact.var] != fact.value) {
+                regressable = false;
+                break;
+            }
+        }
+        if (regressable) {
+            result.push_back(OperatorID(op.get_id()));
+        }
+    }
+}
+
+/*
+  Compute the values of all candidate predecessors from which op could
+  have led to the given state: the variables with a precondition have the
+  precondition value, the variables op changes without a precondition can
+  have any value of their domain, and all other variables have the value
+  they have in state. Values of derived variables are left as they are in
+  state; the registry recomputes them.
+*/
+static void compute_predecessor_candidates(
+    const OperatorProxy &op, const GlobalState &state,
+    const VariablesProxy &variables, vector<vector<int>> &candidates) {
+    candidates.clear();
+    vector<int> values(variables.size());
+    for (size_t var = 0; var < values.size(); ++var) {
+        values[var] = state[var];
+    }
+    vector<bool> has_precondition(variables.size(), false);
+    for (FactProxy precondition : op.get_preconditions()) {
+        FactPair fact = precondition.get_pair();
+        values[fact.var] = fact.value;
+        has_precondition[fact.var] = true;
+    }
+    vector<int> free_vars;
+    for (EffectProxy effect : op.get_effects()) {
+        int var = effect.get_fact().get_variable().get_id();
+        if (!has_precondition[var] &&
+            find(free_vars.begin(), free_vars.end(), var) == free_vars.end()) {
+            free_vars.push_back(var);
+        }
+    }
+
+    // Enumerate all values of the free variables like a mixed-radix counter.
+    for (int var : free_vars) {
+        values[var] = 0;
+    }
+    for (;;) {
+        candidates.push_back(values);
+        size_t i = 0;
+        while (i < free_vars.size()) {
+            int var = free_vars[i];
+            if (++values[var] < variables[var].get_domain_size()) {
+                break;
+            }
+            values[var] = 0;
+            ++i;
+        }
+        if (i == free_vars.size()) {
+            break;
+        }
+    }
+}
+
+/*
+  If a search node s has g-value g(s), the node that last set g(s) reached s
+  via some operator o and had a g-value of at most g(s) - cost(o), since
+  g-values only decrease. We therefore look for any reached node p with
+  g(p) + cost(o) <= g(s) for an operator o leading from p to s. We find
+  such nodes by regressing s through all operators and looking up the
+  candidate predecessors in the registry. Since costs are positive, g
+  strictly decreases until we reach the initial state, the only node with
+  g = 0.
+
+  The adjusted cost of the path is at most the one of the path the search
+  found. If the search uses adjusted costs that differ from the real
+  costs, we prefer predecessors for which the analogous condition also
+  holds for the real g-values, which keeps the real cost of the path at
+  most the one of the path found whenever such predecessors exist.
+*/
+void SearchSpace::trace_path_by_regression(
+    const GlobalState &goal_state, vector<OperatorID> &path) const {
+    const TaskProxy &task_proxy = state_registry.get_task_proxy();
+    OperatorsProxy operators = task_proxy.get_operators();
+    VariablesProxy variables = task_proxy.get_variables();
+    vector<OperatorID> regressable_ops;
+    vector<vector<int>> candidates;
+    vector<int> successor_values;
+
+    GlobalState current_state = goal_state;
+    int current_g = search_node_infos[current_state].g;
+    int current_real_g = store_real_g ? real_g_values[current_state] : current_g;
+    assert(current_g >= 0);
+    while (current_g > 0) {
+        compute_regressable_operators(operators, current_state, regressable_ops);
+        StateID best_id = StateID::no_state;
+        OperatorID best_op_id = OperatorID::no_operator;
+        bool best_keeps_real_g = false;
+        for (OperatorID op_id : regressable_ops) {
+            OperatorProxy op = operators[op_id];
+            int cost = get_adjusted_action_cost(op, cost_type, is_unit_cost);
+            compute_predecessor_candidates(op, current_state, variables, candidates);
+            for (const vector<int> &values : candidates) {
+                StateID id = state_registry.find_state(values);
+                if (id == StateID::no_state) {
+                    continue;
+                }
+                GlobalState state = state_registry.lookup_state(id);
+                const SearchNodeInfo &info = search_node_infos[state];
+                if (info.status == SearchNodeInfo::NEW || info.g < 0 ||
+                    info.g + cost > current_g || !is_applicable(op, state) ||
+                    !leads_to(state, op, current_state, variables, successor_values)) {
+                    continue;
+                }
+                bool keeps_real_g = !store_real_g ||
+                    real_g_values[state] + op.get_cost() <= current_real_g;
+                if (best_id == StateID::no_state ||
+                    (keeps_real_g && !best_keeps_real_g)) {
+                    best_id = id;
+                    best_op_id = op_id;
+                    best_keeps_real_g = keeps_real_g;
+                }
+                if (best_keeps_real_g) {
+                    break;
+                }
+            }
+            if (best_keeps_real_g) {
+                break;
+            }
+        }
+        if (best_id == StateID::no_state) {
+            ABORT("Could not reconstruct the path to a search node.");
+        }
+        path.push_back(best_op_id);
+        current_state = state_registry.lookup_state(best_id);
+        current_g = search_node_infos[current_state].g;
+        current_real_g = store_real_g ? real_g_values[current_state] : current_g;
     }
     reverse(path.begin(), path.end());
 }
@@ -147,14 +398,18 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
         /* The body duplicates SearchNode::dump() but we cannot create
            a search node without discarding the const qualifier. */
         GlobalState state = state_registry.lookup_state(id);
-        const SearchNodeInfo &node_info = search_node_infos[state];
         cout << id << ": ";
         state.dump_fdr();
-        if (node_info.creating_operator != OperatorID::no_operator &&
-            node_info.parent_state_id != StateID::no_state) {
-            OperatorProxy op = operators[node_info.creating_operator.get_index()];
+        if (!store_parents) {
+            cout << " parent not stored" << endl;
+            continue;
+        }
+        const SearchNodeParent &parent = search_node_parents[state];
+        if (parent.creating_operator != OperatorID::no_operator &&
+            parent.parent_state_id != StateID::no_state) {
+            OperatorProxy op = operators[parent.creating_operator.get_index()];
             cout << " created by " << op.get_name()
-                 << " from " << node_info.parent_state_id << endl;
+                 << " from " << parent.parent_state_id << endl;
         } else {
             cout << "has no parent" << endl;
         }
@@ -10,15 +10,20 @@
 
 class GlobalState;
 class OperatorProxy;
+class SearchSpace;
 class TaskProxy;
 
 
 class SearchNode {
-    const StateRegistry &state_registry;
+    SearchSpace &search_space;
     StateID state_id;
     SearchNodeInfo &info;
+
+    void set_parent(const SearchNode &parent_node,
+                    const OperatorProxy &parent_op,
+                    int adjusted_cost);
 public:
-    SearchNode(const StateRegistry &state_registry,
+    SearchNode(SearchSpace &search_space,
                StateID state_id,
                SearchNodeInfo &info);
 
@@ -53,11 +58,32 @@ public:
 
 
 class SearchSpace {
+    friend class SearchNode;
+
     PerStateInformation<SearchNodeInfo> search_node_infos;
+    // Only used if store_parents is true.
+    PerStateInformation<SearchNodeParent> search_node_parents;
+    // Only used if g-values and real g-values can differ.
+    PerStateInformation<int> real_g_values;
 
     StateRegistry &state_registry;
+    const OperatorCost cost_type;
+    const bool is_unit_cost;
+    const bool store_parents;
+    const bool store_real_g;
+
+    void trace_path_by_regression(const GlobalState &goal_state,
+                                  std::vector<OperatorID> &path) const;
 public:
-    explicit SearchSpace(StateRegistry &state_registry);
+    /*
+      Without parent pointers, trace_path() reconstructs the path by
+      searching backward from the goal state through the registered states,
+      which saves memory per state at the cost of plan extraction time. This
+      requires positive (adjusted) operator costs.
+    */
+    SearchSpace(StateRegistry &state_registry,
+                OperatorCost cost_type,
+                bool store_parents);
 
     SearchNode get_node(const GlobalState &state);
     void trace_path(const GlobalState &goal_state,
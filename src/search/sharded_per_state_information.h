@@ -0,0 +1,62 @@
+#ifndef SHARDED_PER_STATE_INFORMATION_H
+#define SHARDED_PER_STATE_INFORMATION_H
+
+#include "sharded_state_registry.h"
+
+#include "algorithms/segmented_vector.h"
+#include "utils/memory.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+  ShardedPerStateInformation is the counterpart of PerStateInformation for
+  states of a ShardedStateRegistry. Entries are stored per shard and
+  indexed by the index of the state within its shard.
+
+  Different threads may access the entries of different states
+  concurrently. Accessing the entry of the same state from several threads
+  requires external synchronization, e.g., by assigning each shard to one
+  thread. References to entries stay valid when other entries are added.
+*/
+template<class Entry>
+class ShardedPerStateInformation {
+    struct Shard {
+        std::mutex mutex;
+        segmented_vector::SegmentedVector<Entry> entries;
+    };
+
+    const ShardedStateRegistry &registry;
+    const Entry default_value;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+public:
+    explicit ShardedPerStateInformation(
+        const ShardedStateRegistry &registry,
+        const Entry &default_value = Entry())
+        : registry(registry),
+          default_value(default_value) {
+        int num_shards = registry.get_num_shards();
+        shards.reserve(num_shards);
+        for (int i = 0; i < num_shards; ++i) {
+            shards.push_back(utils::make_unique_ptr<Shard>());
+        }
+    }
+
+    ShardedPerStateInformation(const ShardedPerStateInformation<Entry> &) = delete;
+    ShardedPerStateInformation &operator=(
+        const ShardedPerStateInformation<Entry> &) = delete;
+
+    Entry &operator[](StateID id) {
+        Shard &shard = *shards[registry.get_shard(id)];
+        size_t index = registry.get_index_in_shard(id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.entries.size() <= index) {
+            shard.entries.resize(index + 1, default_value);
+        }
+        return shard.entries[index];
+    }
+};
+
+#endif
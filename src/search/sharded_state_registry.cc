@@ -0,0 +1,110 @@
+#include "sharded_state_registry.h"
+
+#include "task_utils/task_properties.h"
+#include "utils/memory.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+ShardedStateRegistry::Shard::Shard(int bins_per_state)
+    : state_data_pool(bins_per_state),
+      registered_states(
+          StateIDSemanticHash(state_data_pool, bins_per_state),
+          StateIDSemanticEqual(state_data_pool, bins_per_state)) {
+}
+
+ShardedStateRegistry::ShardedStateRegistry(
+    const TaskProxy &task_proxy, int num_shards)
+    : task_proxy(task_proxy),
+      state_packer(task_properties::g_state_packers[task_proxy]),
+      num_shards(num_shards),
+      bins_per_state(state_packer.get_num_bins()),
+      num_states(0) {
+    assert(num_shards >= 1);
+    task_properties::verify_no_axioms(task_proxy);
+    shards.reserve(num_shards);
+    for (int i = 0; i < num_shards; ++i) {
+        shards.push_back(utils::make_unique_ptr<Shard>(bins_per_state));
+    }
+}
+
+ShardedStateRegistry::~ShardedStateRegistry() {
+}
+
+pair<StateID, bool> ShardedStateRegistry::insert_state(const PackedStateBin *buffer) {
+    packed_state_hashing::HashType hash =
+        packed_state_hashing::compute_hash(buffer, bins_per_state);
+    int shard_id = compute_shard(hash, num_shards);
+    Shard &shard = *shards[shard_id];
+    lock_guard<mutex> lock(shard.mutex);
+    shard.state_data_pool.push_back(buffer);
+    int index = shard.state_data_pool.size() - 1;
+    pair<int, bool> result = shard.registered_states.insert_with_hash(index, hash);
+    bool is_new_entry = result.second;
+    if (is_new_entry) {
+        ++num_states;
+    } else {
+        shard.state_data_pool.pop_back();
+    }
+    return make_pair(StateID(result.first * num_shards + shard_id), is_new_entry);
+}
+
+const PackedStateBin *ShardedStateRegistry::lookup_state_data(StateID id) const {
+    const Shard &shard = *shards[get_shard(id)];
+    lock_guard<mutex> lock(shard.mutex);
+    return shard.state_data_pool[get_index_in_shard(id)];
+}
+
+void ShardedStateRegistry::compute_initial_state_data(
+    vector<PackedStateBin> &buffer) const {
+    // Avoid garbage values in half-full bins.
+    buffer.assign(bins_per_state, 0);
+    State initial_state = task_proxy.get_initial_state();
+    for (size_t i = 0; i < initial_state.size(); ++i) {
+        state_packer.set(buffer.data(), i, initial_state[i].get_value());
+    }
+}
+
+void ShardedStateRegistry::compute_successor_data(
+    const PackedStateBin *predecessor, const OperatorProxy &op,
+    vector<PackedStateBin> &buffer) const {
+    assert(!op.is_axiom());
+    buffer.assign(predecessor, predecessor + bins_per_state);
+    for (EffectProxy effect : op.get_effects()) {
+        bool fires = true;
+        for (FactProxy condition : effect.get_conditions()) {
+            FactPair fact = condition.get_pair();
+            if (state_packer.get(predecessor, fact.var) != fact.value) {
+                fires = false;
+                break;
+            }
+        }
+        if (fires) {
+            FactPair effect_pair = effect.get_fact().get_pair();
+            state_packer.set(buffer.data(), effect_pair.var, effect_pair.value);
+        }
+    }
+}
+
+size_t ShardedStateRegistry::get_shard_size(int shard_id) const {
+    const Shard &shard = *shards[shard_id];
+    lock_guard<mutex> lock(shard.mutex);
+    return shard.registered_states.size();
+}
+
+void ShardedStateRegistry::print_statistics() const {
+    cout << "Number of registered states: " << size() << endl;
+    size_t min_shard_size = numeric_limits<size_t>::max();
+    size_t max_shard_size = 0;
+    for (const unique_ptr<Shard> &shard : shards) {
+        lock_guard<mutex> lock(shard->mutex);
+        size_t shard_size = shard->registered_states.size();
+        min_shard_size = min(min_shard_size, shard_size);
+        max_shard_size = max(max_shard_size, shard_size);
+    }
+    cout << "Registered states per shard: " << min_shard_size << "-"
+         << max_shard_size << endl;
+}
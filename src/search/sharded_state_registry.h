@@ -0,0 +1,166 @@
+#ifndef SHARDED_STATE_REGISTRY_H
+#define SHARDED_STATE_REGISTRY_H
+
+#include "global_state.h"
+#include "packed_state_hashing.h"
+#include "state_id.h"
+#include "task_proxy.h"
+
+#include "algorithms/int_hash_set.h"
+#include "algorithms/int_packer.h"
+#include "algorithms/segmented_vector.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/*
+  ShardedStateRegistry is a thread-safe alternative to StateRegistry for
+  algorithms that register states from several threads, e.g., parallel
+  searches or parallel state sampling. It works on StateIDs and packed
+  state data directly since GlobalState objects are bound to a
+  StateRegistry.
+
+  States are distributed among shards by the hash value of their packed
+  data. Each shard has its own state data pool and hash set, protected by
+  its own mutex, so threads only contend if they register states of the
+  same shard at the same time.
+
+  The ID of a state encodes its shard as
+      id = index_in_shard * num_shards + shard.
+  ShardedPerStateInformation uses the index within the shard to store
+  per-state data densely.
+
+  Since the axiom evaluator of a task is not thread-safe, the registry
+  only supports tasks without axioms.
+*/
+class ShardedStateRegistry {
+    struct StateIDSemanticHash {
+        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        int state_size;
+        StateIDSemanticHash(
+            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            int state_size)
+            : state_data_pool(state_data_pool),
+              state_size(state_size) {
+        }
+
+        int_hash_set::HashType operator()(int index) const {
+            return packed_state_hashing::compute_hash(
+                state_data_pool[index], state_size);
+        }
+    };
+
+    struct StateIDSemanticEqual {
+        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        int state_size;
+        StateIDSemanticEqual(
+            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            int state_size)
+            : state_data_pool(state_data_pool),
+              state_size(state_size) {
+        }
+
+        bool operator()(int lhs, int rhs) const {
+            return packed_state_hashing::are_equal(
+                state_data_pool[lhs], state_data_pool[rhs], state_size);
+        }
+    };
+
+    using StateIndexSet = int_hash_set::IntHashSet<StateIDSemanticHash, StateIDSemanticEqual>;
+
+    struct Shard {
+        /* The mutex also protects lookups because growing the pool may
+           reallocate its table of segments. The segments themselves never
+           move, so pointers to state data stay valid. */
+        mutable std::mutex mutex;
+        segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+        StateIndexSet registered_states;
+
+        explicit Shard(int bins_per_state);
+    };
+
+    TaskProxy task_proxy;
+    const int_packer::IntPacker &state_packer;
+    const int num_shards;
+    const int bins_per_state;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<size_t> num_states;
+
+public:
+    ShardedStateRegistry(const TaskProxy &task_proxy, int num_shards);
+    ~ShardedStateRegistry();
+
+    ShardedStateRegistry(const ShardedStateRegistry &) = delete;
+    ShardedStateRegistry &operator=(const ShardedStateRegistry &) = delete;
+
+    int get_num_shards() const {
+        return num_shards;
+    }
+
+    int get_bins_per_state() const {
+        return bins_per_state;
+    }
+
+    /*
+      Returns the shard of a state with the given hash value, as computed by
+      packed_state_hashing::compute_hash(). The hash sets select buckets by
+      the low bits of the hash value, so we select the shard by the high
+      bits to keep the hash sets of all shards balanced.
+    */
+    static int compute_shard(packed_state_hashing::HashType hash, int num_shards) {
+        return (static_cast<std::uint64_t>(hash) * num_shards) >> 32;
+    }
+
+    int get_shard(StateID id) const {
+        return id.value % num_shards;
+    }
+
+    int get_index_in_shard(StateID id) const {
+        return id.value / num_shards;
+    }
+
+    /*
+      Registers the state with the given packed data if this was not done
+      before. Returns its ID and whether it is new. Thread-safe.
+    */
+    std::pair<StateID, bool> insert_state(const PackedStateBin *buffer);
+
+    /*
+      Returns the packed data of a registered state. The pointer stays valid
+      as long as the registry exists. Thread-safe.
+    */
+    const PackedStateBin *lookup_state_data(StateID id) const;
+
+    int get_state_value(const PackedStateBin *buffer, int var) const {
+        return state_packer.get(buffer, var);
+    }
+
+    /*
+      Write the packed data of the initial state or the packed data of the
+      state that results from applying op to the given state into buffer
+      without registering it. Thread-safe.
+    */
+    void compute_initial_state_data(std::vector<PackedStateBin> &buffer) const;
+    void compute_successor_data(
+        const PackedStateBin *predecessor, const OperatorProxy &op,
+        std::vector<PackedStateBin> &buffer) const;
+
+    /*
+      Returns the number of states registered so far. While other threads
+      insert states, the result is only a snapshot.
+    */
+    size_t size() const {
+        return num_states;
+    }
+
+    // Returns the number of states in the given shard. Thread-safe.
+    size_t get_shard_size(int shard_id) const;
+
+    void print_statistics() const;
+};
+
+#endif
@@ -5,14 +5,21 @@
 
 #include "task_utils/task_properties.h"
 
+#include <algorithm>
+
 using namespace std;
 
-StateRegistry::StateRegistry(const TaskProxy &task_proxy)
+StateRegistry::StateRegistry(
+    const TaskProxy &task_proxy,
+    const shared_ptr<mapped_segment_pool::MappedSegmentPool> &segment_pool)
     : task_proxy(task_proxy),
       state_packer(task_properties::g_state_packers[task_proxy]),
       axiom_evaluator(g_axiom_evaluators[task_proxy]),
       num_variables(task_proxy.get_variables().size()),
-      state_data_pool(get_bins_per_state()),
+      segment_pool(segment_pool),
+      state_data_pool(
+          get_bins_per_state(),
+          mapped_segment_pool::MappedSegmentAllocator<PackedStateBin>(segment_pool)),
       registered_states(
           StateIDSemanticHash(state_data_pool, get_bins_per_state()),
           StateIDSemanticEqual(state_data_pool, get_bins_per_state())),
@@ -82,6 +89,94 @@ GlobalState StateRegistry::get_successor_state(const GlobalState &predecessor, c
     return lookup_state(id);
 }
 
+void StateRegistry::get_successor_states(
+    const GlobalState &predecessor, const vector<OperatorID> &operator_ids,
+    vector<StateID> &successor_ids) {
+    int num_successors = operator_ids.size();
+    int bins_per_state = get_bins_per_state();
+    const PackedStateBin *predecessor_buffer = predecessor.get_packed_buffer();
+    OperatorsProxy operators = task_proxy.get_operators();
+
+    successor_arena.resize(num_successors * bins_per_state);
+    successor_hashes.resize(num_successors);
+    for (int i = 0; i < num_successors; ++i) {
+        PackedStateBin *buffer = &successor_arena[i * bins_per_state];
+        copy(predecessor_buffer, predecessor_buffer + bins_per_state, buffer);
+        OperatorProxy op = operators[operator_ids[i]];
+        for (EffectProxy effect : op.get_effects()) {
+            if (does_fire(effect, predecessor)) {
+                FactPair effect_pair = effect.get_fact().get_pair();
+                state_packer.set(buffer, effect_pair.var, effect_pair.value);
+            }
+        }
+        axiom_evaluator.evaluate(buffer, state_packer);
+        successor_hashes[i] = compute_hash(buffer, bins_per_state);
+        registered_states.prefetch(successor_hashes[i]);
+    }
+
+    successor_ids.clear();
+    for (int i = 0; i < num_successors; ++i) {
+        state_data_pool.push_back(&successor_arena[i * bins_per_state]);
+        StateID id(state_data_pool.size() - 1);
+        pair<int, bool> result = registered_states.insert_with_hash(
+            id.value, successor_hashes[i]);
+        if (!result.second) {
+            state_data_pool.pop_back();
+        }
+        successor_ids.push_back(StateID(result.first));
+    }
+    assert(registered_states.size() == static_cast<int>(state_data_pool.size()));
+}
+
+void StateRegistry::compute_successor_data(
+    const GlobalState &predecessor, const OperatorProxy &op,
+    vector<PackedStateBin> &buffer) const {
+    assert(!op.is_axiom());
+    const PackedStateBin *predecessor_buffer = predecessor.get_packed_buffer();
+    buffer.assign(predecessor_buffer, predecessor_buffer + get_bins_per_state());
+    for (EffectProxy effect : op.get_effects()) {
+        if (does_fire(effect, predecessor)) {
+            FactPair effect_pair = effect.get_fact().get_pair();
+            state_packer.set(buffer.data(), effect_pair.var, effect_pair.value);
+        }
+    }
+    axiom_evaluator.evaluate(buffer.data(), state_packer);
+}
+
+GlobalState StateRegistry::import_state(const PackedStateBin *buffer) {
+    state_data_pool.push_back(buffer);
+    StateID id = insert_id_or_pop_state();
+    return lookup_state(id);
+}
+
+StateID StateRegistry::find_state(const PackedStateBin *buffer) {
+    // The hash set can only compare states that are in the pool.
+    state_data_pool.push_back(buffer);
+    int key = registered_states.find(state_data_pool.size() - 1);
+    state_data_pool.pop_back();
+    if (key == -1) {
+        return StateID::no_state;
+    }
+    return StateID(key);
+}
+
+StateID StateRegistry::find_state(const vector<int> &values) {
+    assert(static_cast<int>(values.size()) == num_variables);
+    vector<PackedStateBin> buffer(get_bins_per_state(), 0);
+    for (int var = 0; var < num_variables; ++var) {
+        state_packer.set(buffer.data(), var, values[var]);
+    }
+    axiom_evaluator.evaluate(buffer.data(), state_packer);
+    return find_state(buffer.data());
+}
+
+void StateRegistry::get_state_data(
+    const GlobalState &state, vector<PackedStateBin> &buffer) const {
+    assert(&state.get_registry() == this);
+    const PackedStateBin *state_buffer = state.get_packed_buffer();
+    buffer.assign(state_buffer, state_buffer + get_bins_per_state());
+}
+
 int StateRegistry::get_bins_per_state() const {
     return state_packer.get_num_bins();
 }
@@ -93,4 +188,8 @@ int StateRegistry::get_state_size_in_bytes() const {
 void StateRegistry::print_statistics() const {
     cout << "Number of registered states: " << size() << endl;
     registered_states.print_statistics();
+    if (segment_pool) {
+        cout << "Bytes in mapped state storage: "
+             << segment_pool->get_mapped_bytes() << endl;
+    }
 }
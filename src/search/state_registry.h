@@ -4,15 +4,20 @@
 #include "abstract_task.h"
 #include "axioms.h"
 #include "global_state.h"
+#include "operator_id.h"
+#include "packed_state_hashing.h"
 #include "state_id.h"
 
 #include "algorithms/int_hash_set.h"
 #include "algorithms/int_packer.h"
+#include "algorithms/mapped_segment_pool.h"
 #include "algorithms/segmented_vector.h"
 #include "algorithms/subscriber.h"
 #include "utils/hash.h"
 
+#include <memory>
 #include <set>
+#include <vector>
 
 /*
   Overview of classes relevant to storing and working with registered states.
@@ -109,40 +114,42 @@
 */
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
+    using StateDataPool = segmented_vector::SegmentedArrayVector<
+        PackedStateBin, mapped_segment_pool::MappedSegmentAllocator<PackedStateBin>>;
+
+    static int_hash_set::HashType compute_hash(
+        const PackedStateBin *data, int state_size) {
+        return packed_state_hashing::compute_hash(data, state_size);
+    }
+
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const StateDataPool &state_data_pool;
         int state_size;
         StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            const StateDataPool &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
               state_size(state_size) {
         }
 
         int_hash_set::HashType operator()(int id) const {
-            const PackedStateBin *data = state_data_pool[id];
-            utils::HashState hash_state;
-            for (int i = 0; i < state_size; ++i) {
-                hash_state.feed(data[i]);
-            }
-            return hash_state.get_hash32();
+            return compute_hash(state_data_pool[id], state_size);
         }
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const StateDataPool &state_data_pool;
         int state_size;
         StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            const StateDataPool &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
               state_size(state_size) {
         }
 
         bool operator()(int lhs, int rhs) const {
-            const PackedStateBin *lhs_data = state_data_pool[lhs];
-            const PackedStateBin *rhs_data = state_data_pool[rhs];
-            return std::equal(lhs_data, lhs_data + state_size, rhs_data);
+            return packed_state_hashing::are_equal(
+                state_data_pool[lhs], state_data_pool[rhs], state_size);
         }
     };
 
@@ -158,25 +165,44 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     AxiomEvaluator &axiom_evaluator;
     const int num_variables;
 
-    segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+    std::shared_ptr<mapped_segment_pool::MappedSegmentPool> segment_pool;
+    StateDataPool state_data_pool;
     StateIDSet registered_states;
 
     GlobalState *cached_initial_state;
 
+    // Reused by get_successor_states() to avoid allocations.
+    std::vector<PackedStateBin> successor_arena;
+    std::vector<int_hash_set::HashType> successor_hashes;
+
     StateID insert_id_or_pop_state();
     int get_bins_per_state() const;
 public:
-    explicit StateRegistry(const TaskProxy &task_proxy);
+    /*
+      If a segment pool is given, the registry stores the state data in it,
+      and so does every PerStateInformation for states of this registry.
+    */
+    explicit StateRegistry(
+        const TaskProxy &task_proxy,
+        const std::shared_ptr<mapped_segment_pool::MappedSegmentPool> &segment_pool = nullptr);
     ~StateRegistry();
 
     const TaskProxy &get_task_proxy() const {
         return task_proxy;
     }
 
+    const std::shared_ptr<mapped_segment_pool::MappedSegmentPool> &get_segment_pool() const {
+        return segment_pool;
+    }
+
     int get_num_variables() const {
         return num_variables;
     }
 
+    const int_packer::IntPacker &get_state_packer() const {
+        return state_packer;
+    }
+
     int get_state_value(const PackedStateBin *buffer, int var) const {
         return state_packer.get(buffer, var);
     }
@@ -200,6 +226,56 @@ public:
     */
     GlobalState get_successor_state(const GlobalState &predecessor, const OperatorProxy &op);
 
+    /*
+      Registers the successors of predecessor for all given operators and
+      writes their IDs into successor_ids in the order of the operators.
+      This is equivalent to calling get_successor_state() for each operator
+      but faster: the successors are built in a reusable arena, all hashes
+      are computed first and the hash set buckets are prefetched before
+      the successors are inserted.
+    */
+    void get_successor_states(
+        const GlobalState &predecessor,
+        const std::vector<OperatorID> &operator_ids,
+        std::vector<StateID> &successor_ids);
+
+    /*
+      Writes the packed data of the state that results from applying op to
+      predecessor into buffer without registering the state. Together with
+      import_state(), this allows moving states between registries of the
+      same task.
+    */
+    void compute_successor_data(
+        const GlobalState &predecessor, const OperatorProxy &op,
+        std::vector<PackedStateBin> &buffer) const;
+
+    /*
+      Returns the state with the given packed data and registers it if this
+      was not done before. The buffer must have been packed for the task of
+      this registry.
+    */
+    GlobalState import_state(const PackedStateBin *buffer);
+
+    /*
+      Returns the ID of the state with the given packed data, or
+      StateID::no_state if no such state is registered. Does not register
+      the state.
+    */
+    StateID find_state(const PackedStateBin *buffer);
+
+    /*
+      Like find_state() above, but for the state in which the non-derived
+      variables have the given values. The values of derived variables are
+      computed from them.
+    */
+    StateID find_state(const std::vector<int> &values);
+
+    /*
+      Copies the packed data of the given state of this registry into buffer.
+    */
+    void get_state_data(
+        const GlobalState &state, std::vector<PackedStateBin> &buffer) const;
+
     /*
       Returns the number of states registered so far.
     */
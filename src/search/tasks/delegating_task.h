@@ -61,6 +61,12 @@ public:
         const AbstractTask *ancestor_task) const final override;
     virtual void convert_state_values_from_parent(std::vector<int> &) const {
     }
+    virtual bool does_convert_state_values(
+        const AbstractTask *ancestor_task) const final override;
+    // Must return true if convert_state_values_from_parent() is overridden.
+    virtual bool does_convert_state_values_from_parent() const {
+        return false;
+    }
 };
 }
 
@@ -66,6 +66,9 @@ public:
     virtual std::vector<int> get_initial_state_values() const override;
     virtual void convert_state_values_from_parent(
         std::vector<int> &values) const override;
+    virtual bool does_convert_state_values_from_parent() const override {
+        return true;
+    }
 
     const std::vector<std::vector<Bitset>> &get_inverse_value_map() {
         if (inverse_value_map.empty()) {
@@ -106,6 +106,8 @@ public:
     virtual void convert_state_values(
         vector<int> &values,
         const AbstractTask *ancestor_task) const override;
+    virtual bool does_convert_state_values(
+        const AbstractTask *ancestor_task) const override;
 };
 
 
@@ -493,6 +495,14 @@ void RootTask::convert_state_values(
     }
 }
 
+bool RootTask::does_convert_state_values(
+    const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid state conversion");
+    }
+    return false;
+}
+
 void read_root_task(istream &in) {
     assert(!g_root_task);
     g_root_task = make_shared<RootTask>(in);
@@ -330,6 +330,28 @@ vector<vector<BDD>> BddBuilder::build_transition_bdds_by_abstraction(
     return transition_bdds;
 }
 
+// ____________________________________________________________________________
+vector<vector<BDD>> BddBuilder::build_transition_bdds_for_operator(
+    const vector<unique_ptr<Abstraction>> &abstractions,
+    const vector<vector<Transition>> &sorted_transitions,
+    const vector<vector<int>> &op_begin,
+    int op_id) const {
+    assert(abstractions.size() == sorted_transitions.size());
+    assert(abstractions.size() == op_begin.size());
+    vector<vector<BDD>> transition_bdds(abstractions.size());
+    for (int abstraction_id = 0; abstraction_id < (int)abstractions.size(); ++abstraction_id) {
+        const Abstraction &abstraction = *abstractions[abstraction_id];
+        const int begin = op_begin[abstraction_id][op_id];
+        const int end = op_begin[abstraction_id][op_id + 1];
+        transition_bdds[abstraction_id].reserve(end - begin);
+        for (int i = begin; i < end; ++i) {
+            transition_bdds[abstraction_id].push_back(
+                abstraction.make_transition_bdd(sorted_transitions[abstraction_id][i]));
+        }
+    }
+    return transition_bdds;
+}
+
 // ____________________________________________________________________________
 bool BddBuilder::is_applicable(const BDD &context, int op_id) const {
     return intersect(context, preconditions[op_id]);
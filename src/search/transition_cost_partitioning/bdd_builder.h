@@ -14,6 +14,7 @@ class SplitTree;
 namespace transition_cost_partitioning {
 class Abstraction;
 class TaskInfo;
+struct Transition;
 
 
 /**
@@ -139,6 +140,19 @@ class BddBuilder {
     vector<vector<BDD>> build_transition_bdds_by_abstraction(
       const vector<unique_ptr<Abstraction>> &abstractions) const;
 
+    /**
+     * Constructs operator regression for the state-changing transitions with label op_id.
+     * sorted_transitions[i] are the transitions of abstraction i sorted by operator and
+     * the transitions with label op_id start at index op_begin[i][op_id] and end before op_begin[i][op_id + 1].
+     * The result is indexed by abstraction and by position relative to op_begin[i][op_id].
+     * Building the bdds operator by operator bounds the number of transition bdds that are alive at once.
+     */
+    vector<vector<BDD>> build_transition_bdds_for_operator(
+      const vector<unique_ptr<Abstraction>> &abstractions,
+      const vector<vector<Transition>> &sorted_transitions,
+      const vector<vector<int>> &op_begin,
+      int op_id) const;
+
     /**
      * Returns true iff the operator is applicable for at least one state contained in context.
      */
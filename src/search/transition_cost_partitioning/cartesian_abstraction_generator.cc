@@ -127,8 +127,10 @@ void CartesianAbstractionGenerator::build_abstractions_for_subtasks(
             subtask,
             max(1, (max_states - num_states) / remaining_subtasks),
             max(1, (max_transitions - num_transitions) / remaining_subtasks),
+            1,
             max_time,
             cegar::PickSplit::MAX_REFINED,
+            true,
             *rng,
             debug);
 
@@ -19,6 +19,7 @@
 #include <cmath>
 #include <vector>
 #include <memory>
+#include <numeric>
 
 using namespace std;
 
@@ -253,18 +254,48 @@ void OptimalTransitionCostPartitioningHeuristic::add_context_cost_constraints(
     const vector<int> costs = task_info.get_operator_costs();
 
     const vector<vector<BDD>> state_bdds = bdd_builder.build_state_bdds_by_abstraction(abstractions);
-    const vector<vector<BDD>> transition_bdds = bdd_builder.build_transition_bdds_by_abstraction(abstractions);
+
+    /* Sort the state-changing transitions of each abstraction by operator with a counting sort.
+       The transitions of abstraction i with label op_id are stored in sorted_transitions[i]
+       from index op_begin[i][op_id] up to, but excluding, index op_begin[i][op_id + 1]. */
+    const int num_abstractions = abstractions.size();
+    vector<vector<int>> op_begin(num_abstractions);
+    vector<vector<Transition>> sorted_transitions(num_abstractions);
+    for (int abstraction_id = 0; abstraction_id < num_abstractions; ++abstraction_id) {
+        const Abstraction &abstraction = *abstractions[abstraction_id];
+        vector<int> &begin = op_begin[abstraction_id];
+        begin.assign(num_operators + 1, 0);
+        abstraction.for_each_transition(
+            [&](const Transition &transition) {
+                ++begin[transition.op_id + 1];
+            }
+        );
+        partial_sum(begin.begin(), begin.end(), begin.begin());
+        vector<int> next_index(begin.begin(), begin.end() - 1);
+        vector<Transition> &transitions = sorted_transitions[abstraction_id];
+        transitions.assign(begin.back(), Transition(UNDEFINED, UNDEFINED, UNDEFINED, UNDEFINED));
+        abstraction.for_each_transition(
+            [&](const Transition &transition) {
+                transitions[next_index[transition.op_id]++] = transition;
+            }
+        );
+    }
 
     const double default_lower_bound = _allow_negative_costs ? -_lp_solver.get_infinity() : 0.;
 
     // we generate contexts per operator because this generates the coarsest contexts for each operator.
     for (int op_id = 0; op_id < num_operators; ++op_id) {
+        // The transition bdds are only built for the current operator and released afterwards.
+        const vector<vector<BDD>> transition_bdds = bdd_builder.build_transition_bdds_for_operator(
+            abstractions, sorted_transitions, op_begin, op_id);
         lp::LPConstraint trivial_constraint(default_lower_bound, costs[op_id]);
         // the context is the set of all states where op is applicable.
         const BDD &trivial_context = bdd_builder.get_precondition_bdd(op_id);
         generate_contexts_recursively(
             bdd_builder, 
             state_bdds,
+            sorted_transitions,
+            op_begin,
             transition_bdds,
             move(trivial_constraint),
             abstractions,
@@ -279,8 +310,10 @@ void OptimalTransitionCostPartitioningHeuristic::add_context_cost_constraints(
 // ____________________________________________________________________________
 void OptimalTransitionCostPartitioningHeuristic::generate_contexts_recursively(
   const BddBuilder &bdd_builder,
-    const vector<vector<BDD>> state_bdds,
-    const vector<vector<BDD>> transition_bdds,
+    const vector<vector<BDD>> &state_bdds,
+    const vector<vector<Transition>> &sorted_transitions,
+    const vector<vector<int>> &op_begin,
+    const vector<vector<BDD>> &transition_bdds,
     lp::LPConstraint &&current_constraint,
     const vector<unique_ptr<Abstraction>> &abstractions,
     std::vector<lp::LPConstraint> &lp_constraints,
@@ -322,45 +355,47 @@ void OptimalTransitionCostPartitioningHeuristic::generate_contexts_recursively(
         // operator is applicable in the abstract state. (1) transition (2) transitions or (3) loop        
         // (1) transition (2) transitions
         bool has_transition = false;
-        abstraction.for_each_transition(
-            [&](const Transition &transition) {
-                if ((source_id != transition.source_id) ||
-                    (cur_op_id != transition.op_id)) {
-                    // Transition does not have cur_op_id label and does not start from source_id.
-                    return;
-                }
-                // There exists at least one transition with cur_op_id. Hence, there can not be any loop.
-                has_transition = true;
-                const BDD &transition_bdd = transition_bdds[cur_abs_id][transition.transition_id];
-                const BDD transition_intersection = transition_bdd * state_intersection;
-                // The transition preimage lies outside the current context.
-                if (transition_intersection == bdd_builder.make_zero()) {
-                    return;
-                }
-
-                // The target of this transition is a dead-end
-                if (!reachability[transition.target_id]) {
-                    infinity_states += transition_intersection;
-                    return;   
-                }
-                
-                // General transition handling (as abstract transition cost term)
-                lp::LPConstraint next_constraint(current_constraint);
-                const int transition_cost_variable = _transition_cost_variables[cur_abs_id][transition.transition_id];
-                assert(transition_cost_variable != UNDEFINED);
-                next_constraint.insert(transition_cost_variable, 1);
-                generate_contexts_recursively(
-                    bdd_builder, 
-                    state_bdds,
-                    transition_bdds,
-                    move(next_constraint),
-                    abstractions,
-                    lp_constraints,
-                    transition_intersection, 
-                    cur_op_id, 
-                    cur_abs_id + 1);
+        const int begin = op_begin[cur_abs_id][cur_op_id];
+        const int end = op_begin[cur_abs_id][cur_op_id + 1];
+        for (int i = begin; i < end; ++i) {
+            const Transition &transition = sorted_transitions[cur_abs_id][i];
+            if (source_id != transition.source_id) {
+                // Transition does not start from source_id.
+                continue;
             }
-        );
+            // There exists at least one transition with cur_op_id. Hence, there can not be any loop.
+            has_transition = true;
+            const BDD &transition_bdd = transition_bdds[cur_abs_id][i - begin];
+            const BDD transition_intersection = transition_bdd * state_intersection;
+            // The transition preimage lies outside the current context.
+            if (transition_intersection == bdd_builder.make_zero()) {
+                continue;
+            }
+
+            // The target of this transition is a dead-end
+            if (!reachability[transition.target_id]) {
+                infinity_states += transition_intersection;
+                continue;
+            }
+
+            // General transition handling (as abstract transition cost term)
+            lp::LPConstraint next_constraint(current_constraint);
+            const int transition_cost_variable = _transition_cost_variables[cur_abs_id][transition.transition_id];
+            assert(transition_cost_variable != UNDEFINED);
+            next_constraint.insert(transition_cost_variable, 1);
+            generate_contexts_recursively(
+                bdd_builder, 
+                state_bdds,
+                sorted_transitions,
+                op_begin,
+                transition_bdds,
+                move(next_constraint),
+                abstractions,
+                lp_constraints,
+                transition_intersection, 
+                cur_op_id, 
+                cur_abs_id + 1);
+        }
         // (3) loop          
         if (!has_transition) {
             looping_states += state_intersection;
@@ -372,6 +407,8 @@ void OptimalTransitionCostPartitioningHeuristic::generate_contexts_recursively(
         generate_contexts_recursively(
             bdd_builder, 
             state_bdds,
+            sorted_transitions,
+            op_begin,
             transition_bdds,
             move(next_constraint),
             abstractions,
@@ -388,6 +425,8 @@ void OptimalTransitionCostPartitioningHeuristic::generate_contexts_recursively(
         generate_contexts_recursively(
             bdd_builder, 
             state_bdds,
+            sorted_transitions,
+            op_begin,
             transition_bdds,
             move(next_constraint),
             abstractions,
@@ -11,6 +11,7 @@ namespace transition_cost_partitioning {
 class BddBuilder;
 class Abstraction;
 class TaskInfo;
+struct Transition;
 
 /*
   This transition cost partitioning heuristics has a cost variable for each
@@ -82,8 +83,10 @@ class OptimalTransitionCostPartitioningHeuristic : public Heuristic {
 
     void generate_contexts_recursively(
       const BddBuilder &bdd_builder,
-      const vector<vector<BDD>> state_bdds,
-      const vector<vector<BDD>> state_transition_bdds,
+      const vector<vector<BDD>> &state_bdds,
+      const vector<vector<Transition>> &sorted_transitions,
+      const vector<vector<int>> &op_begin,
+      const vector<vector<BDD>> &transition_bdds,
       lp::LPConstraint &&current_constraint,
       const vector<unique_ptr<Abstraction>> &abstractions,
       std::vector<lp::LPConstraint> &lp_constraints,